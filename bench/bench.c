@@ -0,0 +1,290 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include <include/driver1306.h>
+#include <include/platform.h>
+#include <include/tilemap.h>
+#include <include/game.h>
+#include <include/solver.h>
+
+#if PICO_ON_DEVICE
+#include "hardware/clocks.h"
+#else
+#include <time.h>
+#endif
+
+/****************************
+* DEFINES
+****************************/
+#define BENCH_MIN_TIME_NS 20000000ull // Cada caso repete até somar pelo menos 20 ms
+
+typedef struct {
+    const char* name;
+    void (*setup)(void);
+    void (*run)(uint32_t iterations);
+} BENCH_CASE_t;
+
+/****************************
+* VARIABLES
+****************************/
+extern const uint8_t font_8x5[];
+
+static uint8_t gBenchBuffer[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+static D1306_t gBenchDisplay = {
+    .i2c = NULL, .width = SCREEN_WIDTH, .height = SCREEN_HEIGHT, .pages = SCREEN_HEIGHT / 8,
+    .buffer = gBenchBuffer, .bufsize = sizeof(gBenchBuffer), .font = font_8x5
+};
+static PLATFORMS_t gBenchPlatforms;
+static volatile int gBenchSink; // Impede que o compilador descarte os resultados
+
+/****************************
+* RELÓGIO
+****************************/
+
+// Host: nanossegundos do relógio monotônico; placa: microssegundos do timer de 1 MHz
+static uint64_t BenchNow(void) {
+#if PICO_ON_DEVICE
+    return time_us_64() * 1000;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+/****************************
+* CASOS: PRIMITIVAS DO DISPLAY
+****************************/
+
+static void RunClear(uint32_t n) { while (n--) D1306_Clear(&gBenchDisplay); }
+
+static void RunDrawPixel(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) D1306_DrawPixel(&gBenchDisplay, i & 127, (i >> 7) & 63);
+}
+
+static void RunDrawSquare4(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) D1306_DrawSquare(&gBenchDisplay, i & 127, (i >> 3) & 63, 4, 4);
+}
+
+static void RunDrawSquarePlatform(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) D1306_DrawSquare(&gBenchDisplay, i & 127, (i >> 3) & 63, 20, 2);
+}
+
+static void RunDrawSquareFull(uint32_t n) {
+    while (n--) D1306_DrawSquare(&gBenchDisplay, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+#define BENCH_CHAR_SCALE(scale) \
+    static void RunDrawCharScale##scale(uint32_t n) { \
+        for (uint32_t i = 0; i < n; i++) D1306_DrawChar(&gBenchDisplay, (i * 6) & 127, 8, scale, 'A' + (i % 26)); \
+    } \
+    static void RunDrawStringScale##scale(uint32_t n) { \
+        while (n--) D1306_DrawString(&gBenchDisplay, 0, 8, scale, "GAME OVER"); \
+    }
+
+BENCH_CHAR_SCALE(1)
+BENCH_CHAR_SCALE(2)
+BENCH_CHAR_SCALE(3)
+BENCH_CHAR_SCALE(4)
+
+static void RunBlitPage(uint32_t n) {
+    static const uint8_t tile[8] = { 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55 };
+    for (uint32_t i = 0; i < n; i++) D1306_BlitPage(&gBenchDisplay, (i * 8) & 127, i & 7, tile, 8);
+}
+
+/****************************
+* CASOS: QUADRO COMPLETO POR ESTADO
+****************************/
+
+static void SetupPlay(void) { srand(1); GAME_Init(1); gCurrentGameState = GAME_STATE_PLAY; }
+static void SetupMenu(void) { SetupPlay(); gCurrentGameState = GAME_STATE_MENU; }
+static void SetupConfig(void) { SetupPlay(); gCurrentGameState = GAME_STATE_CONFIG; }
+static void SetupGameOver(void) { SetupPlay(); gCurrentGameState = GAME_STATE_GAME_OVER; }
+static void SetupLevelComplete(void) { SetupPlay(); gCurrentGameState = GAME_STATE_LEVEL_COMPLETE; }
+
+// PLAY com um tick já dado: o quadro cai no meio dele e interpola jogador, câmera e plataformas
+static void SetupPlayMidTick(void) { SetupPlay(); GAME_StepPlatforms(0); GAME_StepLogic(); }
+
+static void RunRender(uint32_t n) { while (n--) GAME_Render(&gBenchDisplay, 0); }
+
+static void RunRenderMidTick(uint32_t n) { while (n--) GAME_Render(&gBenchDisplay, GAME_LOGIC_PERIOD_MS * 1000 / 2); }
+
+/****************************
+* CASOS: KERNELS DO JOGO
+****************************/
+
+static void RunGameTick(uint32_t n) {
+    for (uint64_t now_us = 0; n--; now_us += GAME_LOGIC_PERIOD_MS * 1000) {
+        GAME_StepPlatforms(now_us);
+        GAME_StepLogic();
+        if (gCurrentGameState != GAME_STATE_PLAY) SetupPlay();
+    }
+}
+
+// Armazenamento cheio: PLATFORM_MAX_COUNT plataformas móveis em colunas de 21 px
+static void FillStore(bool eased) {
+    PLATFORMS_Clear(&gBenchPlatforms);
+    for (int i = 0; i < PLATFORM_MAX_COUNT; i++) {
+        PLATFORMS_Add(&gBenchPlatforms, (PLATFORM_CONFIG_t){
+            .x = (i / 2) * 21, .y = (i & 1) ? 31 : 57, .width = 20, .height = 2, .is_moving = true,
+            .direction = (i & 2) ? DIR_DOWN : DIR_UP, .speed_interval = 1 + i % 5,
+            .travel = eased ? 8 + i % 24 : 0
+        });
+    }
+}
+
+static void SetupFullStore(void) { FillStore(false); }
+
+// Mesmo armazenamento, com todas as plataformas indo e voltando suavizadas
+static void SetupFullStoreEased(void) { FillStore(true); }
+
+static const PLATFORM_BOUNDS_t gBenchBounds = { .top = 0, .bottom = SCREEN_HEIGHT, .reset_offset = 10 };
+
+static void RunMoveFull(uint32_t n) {
+    while (n--) PLATFORMS_Move(&gBenchPlatforms, &gBenchBounds);
+}
+
+// Altura de todas as plataformas 1000 ticks à frente, sem simular os ticks do meio
+static void RunYAtFull(uint32_t n) {
+    int sum = 0;
+    while (n--) {
+        for (int i = 0; i < PLATFORM_MAX_COUNT; i++) sum += PLATFORMS_YAt(&gBenchPlatforms, &gBenchBounds, i, 1000);
+    }
+    gBenchSink = sum;
+}
+
+static void RunFindSupportFull(uint32_t n) {
+    int hits = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        hits += PLATFORMS_FindSupport(&gBenchPlatforms, (i * 7) % 2600, 27 + (i & 31), 4, 4, 1) != PLATFORM_NONE;
+    }
+    gBenchSink = hits;
+}
+
+static void RunQuerySpanFull(uint32_t n) {
+    uint32_t mask[PLATFORM_FLAG_WORDS];
+    int total = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        PLATFORMS_QuerySpan(&gBenchPlatforms, (i * 13) % 2600, (i * 13) % 2600 + SCREEN_WIDTH, mask);
+        total += mask[0] != 0;
+    }
+    gBenchSink = total;
+}
+
+static void RunTerrainIsSolid(uint32_t n) {
+    int solid = 0;
+    for (uint32_t i = 0; i < n; i++) solid += TILEMAP_IsSolid(&gTerrain, i % 300, (i >> 3) & 63);
+    gBenchSink = solid;
+}
+
+static void RunTerrainRender(uint32_t n) {
+    while (n--) TILEMAP_Render(&gTerrain, &gBenchDisplay, 0);
+}
+
+// Nível da semente 1; cada iteração resolve do zero
+static GAME_LEVEL_t gBenchLevel;
+
+static void SetupSolver(void) { SetupPlay(); GAME_SaveLevel(&gBenchLevel); }
+
+// Meta fora de alcance: uma tentativa do sorteio no pior caso, que gasta o orçamento inteiro (alvo: 10 ms na placa)
+static void SetupSolverAttempt(void) { SetupSolver(); gBenchLevel.goal_x = gBenchLevel.world_width; }
+
+static void RunSolver(uint32_t n) {
+    int solved = 0;
+    while (n--) solved += SOLVER_Run(&gBenchLevel, gPlayerSpeed, SOLVER_MAX_TICKS, SOLVER_MAX_EXPANDED, SOLVER_MAX_STATES).solvable;
+    gBenchSink = solved;
+}
+
+static void RunSolverAttempt(uint32_t n) {
+    uint32_t expanded = 0;
+    while (n--) expanded += SOLVER_Run(&gBenchLevel, gPlayerSpeed, SOLVER_MAX_TICKS, SOLVER_LEVEL_EXPANDED, SOLVER_LEVEL_STATES).expanded;
+    gBenchSink = expanded;
+}
+
+static const BENCH_CASE_t gCases[] = {
+    { "D1306_Clear", NULL, RunClear },
+    { "D1306_DrawPixel", NULL, RunDrawPixel },
+    { "D1306_DrawSquare 4x4", NULL, RunDrawSquare4 },
+    { "D1306_DrawSquare 20x2", NULL, RunDrawSquarePlatform },
+    { "D1306_DrawSquare 128x64", NULL, RunDrawSquareFull },
+    { "D1306_DrawChar x1", NULL, RunDrawCharScale1 },
+    { "D1306_DrawChar x2", NULL, RunDrawCharScale2 },
+    { "D1306_DrawChar x3", NULL, RunDrawCharScale3 },
+    { "D1306_DrawChar x4", NULL, RunDrawCharScale4 },
+    { "D1306_DrawString x1 (9 chars)", NULL, RunDrawStringScale1 },
+    { "D1306_DrawString x2 (9 chars)", NULL, RunDrawStringScale2 },
+    { "D1306_DrawString x3 (9 chars)", NULL, RunDrawStringScale3 },
+    { "D1306_DrawString x4 (9 chars)", NULL, RunDrawStringScale4 },
+    { "D1306_BlitPage 8 cols", NULL, RunBlitPage },
+    { "frame MENU", SetupMenu, RunRender },
+    { "frame PLAY", SetupPlay, RunRender },
+    { "frame PLAY interpolado", SetupPlayMidTick, RunRenderMidTick },
+    { "frame CONFIG", SetupConfig, RunRender },
+    { "frame GAME_OVER", SetupGameOver, RunRender },
+    { "frame LEVEL_COMPLETE", SetupLevelComplete, RunRender },
+    { "game tick (move + logic)", SetupPlay, RunGameTick },
+    { "PLATFORMS_Move 256", SetupFullStore, RunMoveFull },
+    { "PLATFORMS_Move 256 suavizadas", SetupFullStoreEased, RunMoveFull },
+    { "PLATFORMS_YAt 256 (+1000 ticks)", SetupFullStore, RunYAtFull },
+    { "PLATFORMS_YAt 256 suavizadas", SetupFullStoreEased, RunYAtFull },
+    { "PLATFORMS_FindSupport 256", SetupFullStore, RunFindSupportFull },
+    { "PLATFORMS_QuerySpan 256", SetupFullStore, RunQuerySpanFull },
+    { "TILEMAP_IsSolid", SetupPlay, RunTerrainIsSolid },
+    { "TILEMAP_Render", SetupPlay, RunTerrainRender },
+    { "SOLVER_Run (nivel)", SetupSolver, RunSolver },
+    { "SOLVER_Run (tentativa)", SetupSolverAttempt, RunSolverAttempt },
+};
+
+/****************************
+* EXECUÇÃO
+****************************/
+
+// Dobra as iterações até o caso durar BENCH_MIN_TIME_NS; devolve ns por operação
+static double RunCase(const BENCH_CASE_t* c, uint32_t* iterations) {
+    uint32_t n = 1;
+    for (;;) {
+        if (c->setup) c->setup();
+        uint64_t start = BenchNow();
+        c->run(n);
+        uint64_t elapsed = BenchNow() - start;
+        if (elapsed >= BENCH_MIN_TIME_NS || n >= (1u << 30)) {
+            *iterations = n;
+            return (double)elapsed / n;
+        }
+        n *= 2;
+    }
+}
+
+static void RunAll(void) {
+#if PICO_ON_DEVICE
+    double cycles_per_ns = clock_get_hz(clk_sys) / 1e9;
+    printf("%-32s %12s %12s\n", "caso", "iteracoes", "ciclos/op");
+#else
+    printf("%-32s %12s %12s\n", "caso", "iteracoes", "ns/op");
+#endif
+    for (size_t i = 0; i < sizeof(gCases) / sizeof(gCases[0]); i++) {
+        uint32_t iterations;
+        double ns = RunCase(&gCases[i], &iterations);
+#if PICO_ON_DEVICE
+        printf("%-32s %12lu %12.1f\n", gCases[i].name, (unsigned long)iterations, ns * cycles_per_ns);
+#else
+        printf("%-32s %12lu %12.1f\n", gCases[i].name, (unsigned long)iterations, ns);
+#endif
+    }
+}
+
+/****************************
+* MAIN
+****************************/
+int main() {
+    stdio_init_all();
+#if PICO_ON_DEVICE
+    sleep_ms(2000); // Tempo para o terminal USB conectar
+#endif
+    RunAll();
+#if PICO_ON_DEVICE
+    while (1) tight_loop_contents();
+#endif
+    return 0;
+}
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include <include/game.h>
+#include <include/random.h>
+#include <include/replay.h>
+
+#if !PICO_ON_DEVICE
+#include <time.h>
+#endif
+
+/****************************
+* DEFINES
+****************************/
+#define HEADLESS_INPUT_EVERY (GAME_INPUT_PERIOD_MS / GAME_LOGIC_PERIOD_MS) // Ticks de lógica por amostra de botões
+#define HEADLESS_SETTLE_SAMPLES (200 / GAME_INPUT_PERIOD_MS + 1)        // Espera o debounce de troca de tela (200 ms)
+#define HEADLESS_LONG_PRESS_SAMPLES (1000 / GAME_INPUT_PERIOD_MS + 1)    // Segura A o bastante para o modo infinito
+
+#if PICO_ON_DEVICE
+#define HEADLESS_DEFAULT_SEEDS 8
+#else
+#define HEADLESS_DEFAULT_SEEDS 64
+#endif
+#define HEADLESS_DEFAULT_TICKS 6000 // 60 s de jogo simulado por execução
+#define HEADLESS_REPLAY_CAPACITY (64 * 1024)
+
+#define BUTTONS_NONE 0
+#define BUTTONS_A REPLAY_BUTTON_A
+#define BUTTONS_B REPLAY_BUTTON_B
+
+// Política: botões durante o PLAY; menus e telas de fim são navegados pelo próprio runner
+typedef struct {
+    const char* name;
+    GAME_MODE_t mode;
+    uint8_t (*play)(uint32_t sample, uint32_t* random);
+} HEADLESS_POLICY_t;
+
+typedef struct {
+    uint64_t ticks;         // Ticks de lógica simulados (GAME_LOGIC_PERIOD_MS cada)
+    uint64_t play_ticks;    // Desses, quantos em GAME_STATE_PLAY
+    uint32_t levels;
+    uint32_t deaths;
+    uint64_t wall_us;
+} HEADLESS_STATS_t;
+
+/****************************
+* RELÓGIO
+****************************/
+
+// Host: relógio monotônico (time_us_64 é o relógio simulado do HAL); placa: timer de 1 MHz
+static uint64_t HeadlessNow(void) {
+#if PICO_ON_DEVICE
+    return time_us_64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ull + ts.tv_nsec / 1000;
+#endif
+}
+
+/****************************
+* POLÍTICAS
+****************************/
+static uint8_t PlayRight(uint32_t sample, uint32_t* random) { (void)sample; (void)random; return BUTTONS_B; }
+
+static uint8_t PlaySteps(uint32_t sample, uint32_t* random) { (void)random; return (sample % 3 == 0) ? BUTTONS_B : BUTTONS_NONE; }
+
+// Anda mais para a direita do que para a esquerda, com pausas
+static uint8_t PlayRandom(uint32_t sample, uint32_t* random) {
+    (void)sample;
+    int roll = RANDOM_Below(random, 20);
+    return roll < 12 ? BUTTONS_B : roll < 15 ? BUTTONS_A : BUTTONS_NONE;
+}
+
+static const HEADLESS_POLICY_t gPolicies[] = {
+    { "direita", GAME_MODE_LEVELS, PlayRight },
+    { "passos", GAME_MODE_LEVELS, PlaySteps },
+    { "aleatorio", GAME_MODE_LEVELS, PlayRandom },
+    { "infinito-passos", GAME_MODE_ENDLESS, PlaySteps },
+    { "infinito-aleatorio", GAME_MODE_ENDLESS, PlayRandom },
+};
+
+// Fora do PLAY: espera o debounce e clica A (ou segura, no menu do modo infinito), em ciclo até a tela mudar
+static uint8_t Navigate(GAME_MODE_t mode, uint32_t state_samples) {
+    uint32_t hold = (gCurrentGameState == GAME_STATE_MENU && mode == GAME_MODE_ENDLESS) ? HEADLESS_LONG_PRESS_SAMPLES : 1;
+    uint32_t phase = state_samples % (HEADLESS_SETTLE_SAMPLES + hold + 1);
+
+    return (phase >= HEADLESS_SETTLE_SAMPLES && phase < HEADLESS_SETTLE_SAMPLES + hold) ? BUTTONS_A : BUTTONS_NONE;
+}
+
+/****************************
+* EXECUÇÃO
+****************************/
+
+// Mesma ordem do escalonador simulado: entrada, plataformas, lógica; sem renderizar
+static void Run(uint32_t seed, const HEADLESS_POLICY_t* policy, REPLAY_t* replay, uint32_t ticks, HEADLESS_STATS_t* stats) {
+    uint32_t random = RANDOM_Seed(seed ^ 0x5DEECE66u);
+    uint32_t sample = 0, state_samples = 0;
+    GAME_STATE_t last_state;
+
+    if (replay) { seed = replay->seed; REPLAY_Rewind(replay); }
+    GAME_Init(seed);
+    last_state = gCurrentGameState;
+
+    uint64_t start = HeadlessNow();
+    for (uint32_t tick = 0; tick < ticks; tick++) {
+        uint64_t now_us = (uint64_t)tick * GAME_LOGIC_PERIOD_MS * 1000;
+
+        if (tick % HEADLESS_INPUT_EVERY == 0) {
+            uint8_t buttons;
+            if (replay) { REPLAY_Next(replay, &buttons); }
+            else if (gCurrentGameState == GAME_STATE_PLAY) { buttons = policy->play(sample, &random); }
+            else { buttons = Navigate(policy->mode, state_samples); }
+
+            GAME_Input(buttons & BUTTONS_A, buttons & BUTTONS_B, now_us);
+            sample++; state_samples++;
+        }
+        GAME_StepPlatforms(now_us);
+        GAME_StepLogic();
+
+        if (gCurrentGameState != last_state) {
+            if (gCurrentGameState == GAME_STATE_GAME_OVER) stats->deaths++;
+            if (gCurrentGameState == GAME_STATE_LEVEL_COMPLETE) stats->levels++;
+            last_state = gCurrentGameState;
+            state_samples = 0;
+        }
+        if (gCurrentGameState == GAME_STATE_PLAY) stats->play_ticks++;
+    }
+    stats->wall_us += HeadlessNow() - start;
+    stats->ticks += ticks;
+}
+
+static void PrintHeader(void) {
+    printf("%-20s %6s %12s %14s %8s %8s %8s\n", "politica", "sem.", "ticks", "ticks/s", "niveis", "mortes", "jogo %");
+}
+
+static void PrintStats(const char* name, uint32_t runs, const HEADLESS_STATS_t* stats) {
+    double seconds = stats->wall_us / 1e6;
+    printf("%-20s %6lu %12llu %14.0f %8lu %8lu %8.1f\n", name, (unsigned long)runs,
+           (unsigned long long)stats->ticks, seconds > 0 ? stats->ticks / seconds : 0.0,
+           (unsigned long)stats->levels, (unsigned long)stats->deaths,
+           stats->ticks ? 100.0 * stats->play_ticks / stats->ticks : 0.0);
+}
+
+static void RunAll(uint32_t first_seed, uint32_t seeds, uint32_t ticks) {
+    HEADLESS_STATS_t total = { 0 };
+
+    PrintHeader();
+    for (size_t p = 0; p < sizeof(gPolicies) / sizeof(gPolicies[0]); p++) {
+        HEADLESS_STATS_t stats = { 0 };
+        for (uint32_t s = 0; s < seeds; s++) Run(first_seed + s, &gPolicies[p], NULL, ticks, &stats);
+        PrintStats(gPolicies[p].name, seeds, &stats);
+
+        total.ticks += stats.ticks; total.play_ticks += stats.play_ticks; total.wall_us += stats.wall_us;
+        total.levels += stats.levels; total.deaths += stats.deaths;
+    }
+    PrintStats("total", seeds * (sizeof(gPolicies) / sizeof(gPolicies[0])), &total);
+    printf("simulado %.0fx mais rapido que o tempo real\n",
+           total.wall_us ? total.ticks * GAME_LOGIC_PERIOD_MS * 1000.0 / total.wall_us : 0.0);
+}
+
+/****************************
+* MAIN
+****************************/
+#if PICO_ON_DEVICE
+int main() {
+    stdio_init_all();
+    sleep_ms(2000); // Tempo para o terminal USB conectar
+    RunAll(1, HEADLESS_DEFAULT_SEEDS, HEADLESS_DEFAULT_TICKS);
+    while (1) tight_loop_contents();
+}
+#else
+static void Usage(const char* program) {
+    fprintf(stderr,
+            "uso: %s [--seeds N] [--first N] [--ticks N] [--replay arquivo]\n"
+            "  --seeds N         sementes por politica (padrao %d)\n"
+            "  --first N         primeira semente (padrao 1)\n"
+            "  --ticks N         ticks de %d ms por execucao (padrao %d)\n"
+            "  --replay arquivo  em vez das politicas, repete uma gravacao de chaos-host --record\n",
+            program, HEADLESS_DEFAULT_SEEDS, GAME_LOGIC_PERIOD_MS, HEADLESS_DEFAULT_TICKS);
+}
+
+int main(int argc, char** argv) {
+    uint32_t seeds = HEADLESS_DEFAULT_SEEDS, first_seed = 1, ticks = HEADLESS_DEFAULT_TICKS;
+    const char* replay_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seeds") && i + 1 < argc) { seeds = strtoul(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--first") && i + 1 < argc) { first_seed = strtoul(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) { ticks = strtoul(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) { replay_path = argv[++i]; }
+        else { Usage(argv[0]); return 2; }
+    }
+
+    if (!replay_path) {
+        RunAll(first_seed, seeds, ticks);
+        return 0;
+    }
+
+    // Gravação: lê o fluxo e o repete sem renderizar, tantas vezes quanto --seeds
+    static uint8_t data[HEADLESS_REPLAY_CAPACITY];
+    FILE* file = fopen(replay_path, "rb");
+    size_t size = file ? fread(data, 1, sizeof(data), file) : 0;
+    if (file) fclose(file);
+
+    REPLAY_t* replay = REPLAY_Init(HEADLESS_REPLAY_CAPACITY);
+    if (!REPLAY_Load(replay, data, size)) {
+        fprintf(stderr, "gravacao invalida: %s\n", replay_path);
+        return 1;
+    }
+
+    uint32_t replay_ticks = REPLAY_GetSamples(replay) * HEADLESS_INPUT_EVERY;
+    HEADLESS_STATS_t stats = { 0 };
+    for (uint32_t s = 0; s < seeds; s++) Run(0, NULL, replay, replay_ticks, &stats);
+
+    PrintHeader();
+    PrintStats("gravacao", seeds, &stats);
+    return 0;
+}
+#endif
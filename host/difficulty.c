@@ -0,0 +1,427 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <include/game.h>
+#include <include/random.h>
+#include <include/solver.h>
+
+/****************************
+* DEFINES
+****************************/
+#define DIFFICULTY_DEFAULT_SEEDS 64
+#define DIFFICULTY_DEFAULT_RUNS 256
+#define DIFFICULTY_MAX_THREADS 256
+#define DIFFICULTY_BATCH_RUNS 16        // Corridas por tarefa: o bastante para amortizar o roubo
+#define DIFFICULTY_RUN_TICKS 3000       // 30 s de jogo por corrida; depois disso conta como falha
+#define DIFFICULTY_BIN_TICKS 10         // Histograma do tempo até a meta em passos de 100 ms
+#define DIFFICULTY_BINS (DIFFICULTY_RUN_TICKS / DIFFICULTY_BIN_TICKS)
+#define DIFFICULTY_MAX_MISTAKE 100     // Pior bot: 10% das amostras com botões ao acaso
+#define DIFFICULTY_MIN_HORIZON 50      // Visão do bot em ticks, sorteada por corrida entre estes limites
+#define DIFFICULTY_MAX_HORIZON 400
+#define DIFFICULTY_INPUT_EVERY (GAME_INPUT_PERIOD_MS / GAME_LOGIC_PERIOD_MS)
+
+#define BUTTONS_A 1
+#define BUTTONS_B 2
+
+typedef struct {
+    uint32_t seed;
+    GAME_LEVEL_t level;             // Primeiro nível da semente, como o jogador o recebe
+    SOLVER_RESULT_t solver;
+    bool beam;                      // O feixe do jogo (SOLVER_LEVEL_*) também acha o caminho
+    pthread_mutex_t lock;           // Protege os acumuladores abaixo
+    uint32_t runs;
+    uint32_t completions;
+    uint32_t histogram[DIFFICULTY_BINS];
+} DIFFICULTY_LEVEL_t;
+
+typedef struct {
+    uint32_t level;
+    uint32_t first_run;
+    uint32_t runs;
+} DIFFICULTY_TASK_t;
+
+// Fila de tarefas de uma thread: índices [head, tail) do vetor de tarefas da fase.
+// O dono consome pela frente; quem rouba leva a metade de trás.
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t executed;
+    uint32_t stolen;
+} DIFFICULTY_DEQUE_t;
+
+typedef struct {
+    int id;
+    void (*work)(uint32_t task);
+} DIFFICULTY_WORKER_t;
+
+/****************************
+* VARIABLES
+****************************/
+static DIFFICULTY_LEVEL_t* gLevels;
+static uint32_t gLevelCount;
+static DIFFICULTY_TASK_t* gTasks;
+static DIFFICULTY_DEQUE_t gDeques[DIFFICULTY_MAX_THREADS];
+static int gThreads;
+
+/****************************
+* POOL COM ROUBO DE TRABALHO
+****************************/
+
+static bool PopOwn(DIFFICULTY_DEQUE_t* deque, uint32_t* task) {
+    pthread_mutex_lock(&deque->lock);
+    bool ok = deque->head < deque->tail;
+    if (ok) *task = deque->head++;
+    pthread_mutex_unlock(&deque->lock);
+    return ok;
+}
+
+// Rouba a metade de trás da primeira fila não vazia; como nenhuma tarefa nova aparece,
+// todas as filas vazias significa fim da fase
+static bool Steal(int id, uint32_t* task) {
+    for (int k = 1; k < gThreads; k++) {
+        DIFFICULTY_DEQUE_t* victim = &gDeques[(id + k) % gThreads];
+        uint32_t first = 0, last = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->head < victim->tail) {
+            last = victim->tail;
+            first = last - (last - victim->head + 1) / 2;
+            victim->tail = first;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (first == last) continue;
+
+        DIFFICULTY_DEQUE_t* own = &gDeques[id];
+        pthread_mutex_lock(&own->lock);
+        own->head = first + 1; own->tail = last;
+        own->stolen += last - first;
+        pthread_mutex_unlock(&own->lock);
+        *task = first;
+        return true;
+    }
+    return false;
+}
+
+static void* Worker(void* arg) {
+    DIFFICULTY_WORKER_t* worker = arg;
+    uint32_t task;
+
+    while (PopOwn(&gDeques[worker->id], &task) || Steal(worker->id, &task)) {
+        worker->work(task);
+        gDeques[worker->id].executed++;
+    }
+    return NULL;
+}
+
+// Reparte as tarefas em fatias contíguas, uma por thread, e espera todas terminarem
+static void RunPhase(uint32_t count, void (*work)(uint32_t)) {
+    pthread_t threads[DIFFICULTY_MAX_THREADS];
+    DIFFICULTY_WORKER_t workers[DIFFICULTY_MAX_THREADS];
+
+    for (int t = 0; t < gThreads; t++) {
+        gDeques[t].head = (uint32_t)((uint64_t)count * t / gThreads);
+        gDeques[t].tail = (uint32_t)((uint64_t)count * (t + 1) / gThreads);
+        workers[t] = (DIFFICULTY_WORKER_t){ .id = t, .work = work };
+        pthread_create(&threads[t], NULL, Worker, &workers[t]);
+    }
+    for (int t = 0; t < gThreads; t++) pthread_join(threads[t], NULL);
+}
+
+/****************************
+* FASES
+****************************/
+
+// Cada thread tem seu próprio jogo (CHAOS_GAME_TLS): menu, clique em A, e o nível que aparece
+static void GenerateLevel(uint32_t i) {
+    DIFFICULTY_LEVEL_t* entry = &gLevels[i];
+
+    GAME_Init(entry->seed);
+    GAME_Input(true, false, 1000);
+    GAME_Input(false, false, 2000);
+    GAME_SaveLevel(&entry->level);
+    entry->solver = SOLVER_Run(&entry->level, gPlayerSpeed, SOLVER_MAX_TICKS, SOLVER_MAX_EXPANDED, SOLVER_MAX_STATES);
+    entry->beam = SOLVER_Run(&entry->level, gPlayerSpeed, SOLVER_MAX_TICKS, SOLVER_LEVEL_EXPANDED, SOLVER_LEVEL_STATES).solvable;
+}
+
+// Apoio firme sob [x, x + PLAYER_WIDTH) na altura dos pés, contra as plataformas dadas
+static bool SupportAt(const PLATFORMS_t* platforms, int x, int y) {
+    for (int px = x; px < x + PLAYER_WIDTH; px++) {
+        if (TILEMAP_IsSolid(&gTerrain, px, y + PLAYER_HEIGHT)) return true;
+    }
+    return PLATFORMS_FindSupport(platforms, x, y, PLAYER_WIDTH, PLAYER_HEIGHT, PLAYER_GRAVITY) != PLATFORM_NONE;
+}
+
+// Bot com visão limitada: para cada opção (direita, nada, esquerda) aplica os botões agora e
+// segue horizon ticks numa cópia das plataformas, com a física do jogo, dando passos para a
+// direita só quando caem em apoio. As plataformas não
+// dependem do personagem, então as três opções andam juntas sobre a mesma cópia.
+// Fica com a que chega à meta, ou vive mais, ou termina mais à direita; com chance mistake (por mil)
+// aperta qualquer coisa, como um jogador distraído.
+static uint8_t BotButtons(uint32_t* random, int mistake, uint32_t horizon) {
+    static const uint8_t options[] = { BUTTONS_B, 0, BUTTONS_A };
+    PLATFORMS_t future;
+    int x[3], y[3], state[3]; // state: 0 morto, 1 vivo, 2 na meta
+    uint32_t alive[3];        // Ticks até morrer (ou chegar)
+
+    if (RANDOM_Below(random, 1000) < mistake) return RANDOM_Below(random, 4);
+
+    memcpy(&future, &gPlatforms, sizeof(future));
+    for (int o = 0; o < 3; o++) {
+        x[o] = GAME_PlayerInputX(gPlayerPos[0], options[o] & BUTTONS_A, options[o] & BUTTONS_B);
+        y[o] = gPlayerPos[1];
+        state[o] = 1; alive[o] = horizon;
+    }
+    for (uint32_t tick = 0; tick < horizon; tick++) {
+        PLATFORMS_Move(&future, &gPlatformBounds);
+        for (int o = 0; o < 3; o++) {
+            if (state[o] != 1) continue;
+            if (tick % DIFFICULTY_INPUT_EVERY == DIFFICULTY_INPUT_EVERY - 1) {
+                int next = GAME_PlayerInputX(x[o], false, true);
+                if (SupportAt(&future, next, y[o])) x[o] = next;
+            }
+            int support = PLATFORMS_FindSupport(&future, x[o], y[o], PLAYER_WIDTH, PLAYER_HEIGHT, PLAYER_GRAVITY);
+            GAME_PLAYER_STEP_t step = GAME_StepPlayer(&future, &gTerrain, gGoalX, support, &x[o], &y[o]);
+            if (step == GAME_PLAYER_DEAD) { state[o] = 0; alive[o] = tick; }
+            else if (step == GAME_PLAYER_GOAL) state[o] = 2;
+        }
+    }
+
+    int best = 0;
+    for (int o = 1; o < 3; o++) {
+        if (state[o] != state[best]) { if (state[o] > state[best]) best = o; }
+        else if (alive[o] != alive[best]) { if (alive[o] > alive[best]) best = o; }
+        else if (state[o] == 1 && x[o] > x[best]) best = o;
+    }
+    return options[best];
+}
+
+// Ticks até a meta, ou 0 se morreu ou estourou o tempo
+static uint32_t PlayRun(const GAME_LEVEL_t* level, uint32_t* random, int mistake, uint32_t horizon) {
+    GAME_PlayLevel(level, 0);
+
+    for (uint32_t tick = 0; tick < DIFFICULTY_RUN_TICKS; tick++) {
+        uint64_t now_us = (uint64_t)tick * GAME_LOGIC_PERIOD_MS * 1000;
+        if (tick % DIFFICULTY_INPUT_EVERY == 0) {
+            uint8_t buttons = BotButtons(random, mistake, horizon);
+            GAME_Input(buttons & BUTTONS_A, buttons & BUTTONS_B, now_us);
+        }
+        GAME_StepPlatforms(now_us);
+        GAME_StepLogic();
+        if (gCurrentGameState == GAME_STATE_LEVEL_COMPLETE) return tick + 1;
+        if (gCurrentGameState != GAME_STATE_PLAY) return 0;
+    }
+    return 0;
+}
+
+// A semente de cada corrida depende só de (nível, corrida): o resultado não muda com o número de threads
+static void RunBatch(uint32_t t) {
+    const DIFFICULTY_TASK_t* task = &gTasks[t];
+    DIFFICULTY_LEVEL_t* entry = &gLevels[task->level];
+    uint32_t completions = 0;
+    uint32_t histogram[DIFFICULTY_BINS] = { 0 };
+
+    for (uint32_t r = task->first_run; r < task->first_run + task->runs; r++) {
+        uint32_t random = RANDOM_Seed(entry->seed * 0x9E3779B9u ^ (r + 1) * 0x85EBCA6Bu);
+        // Habilidade sorteada por corrida: quanto o bot enxerga à frente e quanto erra
+        uint32_t horizon = DIFFICULTY_MIN_HORIZON + RANDOM_Below(&random, DIFFICULTY_MAX_HORIZON - DIFFICULTY_MIN_HORIZON + 1);
+        int mistake = RANDOM_Below(&random, DIFFICULTY_MAX_MISTAKE + 1);
+        uint32_t ticks = PlayRun(&entry->level, &random, mistake, horizon);
+        if (ticks) { completions++; histogram[(ticks - 1) / DIFFICULTY_BIN_TICKS]++; }
+    }
+
+    pthread_mutex_lock(&entry->lock);
+    entry->runs += task->runs;
+    entry->completions += completions;
+    for (int b = 0; b < DIFFICULTY_BINS; b++) entry->histogram[b] += histogram[b];
+    pthread_mutex_unlock(&entry->lock);
+}
+
+/****************************
+* RESULTADOS
+****************************/
+
+// Tempo (ms) em que a fração q das conclusões já chegou à meta
+static uint32_t Percentile(const DIFFICULTY_LEVEL_t* entry, double q) {
+    uint32_t target = (uint32_t)(entry->completions * q + 0.5), seen = 0;
+    if (!entry->completions) return 0;
+    if (target == 0) target = 1;
+    for (int b = 0; b < DIFFICULTY_BINS; b++) {
+        seen += entry->histogram[b];
+        if (seen >= target) return (b + 1) * DIFFICULTY_BIN_TICKS * GAME_LOGIC_PERIOD_MS;
+    }
+    return DIFFICULTY_RUN_TICKS * GAME_LOGIC_PERIOD_MS;
+}
+
+// 0 = todo bot completa, 100 = nenhum; empates se desfazem pela mediana do tempo
+static double Score(const DIFFICULTY_LEVEL_t* entry) {
+    return entry->runs ? 100.0 * (entry->runs - entry->completions) / entry->runs : 100.0;
+}
+
+static int CompareDifficulty(const void* a, const void* b) {
+    const DIFFICULTY_LEVEL_t* x = *(DIFFICULTY_LEVEL_t* const*)a;
+    const DIFFICULTY_LEVEL_t* y = *(DIFFICULTY_LEVEL_t* const*)b;
+    double dx = Score(x), dy = Score(y);
+    if (dx != dy) return dx < dy ? -1 : 1;
+    uint32_t px = Percentile(x, 0.5), py = Percentile(y, 0.5);
+    if (px != py) return px < py ? -1 : 1;
+    return x->seed < y->seed ? -1 : x->seed > y->seed;
+}
+
+static void PrintTable(void) {
+    printf("%10s %10s %10s %10s %10s %12s\n", "semente", "otimo ms", "conclusao", "p50 ms", "p90 ms", "dificuldade");
+    for (uint32_t i = 0; i < gLevelCount; i++) {
+        const DIFFICULTY_LEVEL_t* entry = &gLevels[i];
+        char optimal[16] = "-";
+        if (entry->solver.solvable) snprintf(optimal, sizeof(optimal), "%lu", (unsigned long)entry->solver.ticks * GAME_LOGIC_PERIOD_MS);
+        printf("%10lu %10s %9.1f%% %10lu %10lu %12.1f\n", (unsigned long)entry->seed, optimal,
+               100.0 * entry->completions / entry->runs,
+               (unsigned long)Percentile(entry, 0.5), (unsigned long)Percentile(entry, 0.9), Score(entry));
+    }
+}
+
+// Falsos negativos do feixe contra a busca completa: sem ela, esses níveis seriam descartados
+static void PrintBeam(void) {
+    uint32_t solvable = 0, missed = 0;
+    for (uint32_t i = 0; i < gLevelCount; i++) {
+        if (!gLevels[i].solver.solvable) continue;
+        solvable++;
+        if (!gLevels[i].beam) missed++;
+    }
+    printf("\nfeixe do jogo (%d estados/tick, %d expansoes): %lu de %lu niveis soluveis sem caminho (%.1f%%)\n",
+           SOLVER_LEVEL_STATES, SOLVER_LEVEL_EXPANDED, (unsigned long)missed, (unsigned long)solvable,
+           solvable ? 100.0 * missed / solvable : 0.0);
+}
+
+static bool WriteCsv(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "seed,solvable,optimal_ms,runs,completions,p50_ms,p90_ms,difficulty\n");
+    for (uint32_t i = 0; i < gLevelCount; i++) {
+        const DIFFICULTY_LEVEL_t* entry = &gLevels[i];
+        fprintf(file, "%lu,%d,%lu,%lu,%lu,%lu,%lu,%.2f\n", (unsigned long)entry->seed, entry->solver.solvable,
+                (unsigned long)(entry->solver.solvable ? entry->solver.ticks * GAME_LOGIC_PERIOD_MS : 0),
+                (unsigned long)entry->runs, (unsigned long)entry->completions,
+                (unsigned long)Percentile(entry, 0.5), (unsigned long)Percentile(entry, 0.9), Score(entry));
+    }
+    return fclose(file) == 0;
+}
+
+// Pacote: size níveis espalhados por toda a faixa de dificuldade, do mais fácil ao mais difícil.
+// Só entram níveis que o solver resolve e que algum bot completou.
+static bool WritePack(const char* path, uint32_t size) {
+    DIFFICULTY_LEVEL_t** sorted = malloc(gLevelCount * sizeof(*sorted));
+    uint32_t candidates = 0;
+
+    for (uint32_t i = 0; i < gLevelCount; i++) {
+        if (gLevels[i].solver.solvable && gLevels[i].completions) sorted[candidates++] = &gLevels[i];
+    }
+    qsort(sorted, candidates, sizeof(*sorted), CompareDifficulty);
+    if (size > candidates) size = candidates;
+
+    FILE* file = fopen(path, "w");
+    if (!file) { free(sorted); return false; }
+
+    fprintf(file, "# pacote de niveis: %lu de %lu candidatos, do mais facil ao mais dificil\n",
+            (unsigned long)size, (unsigned long)candidates);
+    fprintf(file, "# semente dificuldade conclusao_%% p50_ms\n");
+    for (uint32_t k = 0; k < size; k++) {
+        const DIFFICULTY_LEVEL_t* entry = sorted[size > 1 ? (uint64_t)k * (candidates - 1) / (size - 1) : 0];
+        fprintf(file, "%lu %.1f %.1f %lu\n", (unsigned long)entry->seed, Score(entry),
+                100.0 * entry->completions / entry->runs, (unsigned long)Percentile(entry, 0.5));
+    }
+
+    free(sorted);
+    return fclose(file) == 0;
+}
+
+static double Seconds(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/****************************
+* MAIN
+****************************/
+static void Usage(const char* program) {
+    fprintf(stderr,
+            "uso: %s [--seeds N] [--first N] [--runs N] [--threads N] [--csv arquivo] [--pack arquivo N]\n"
+            "  --seeds N          niveis avaliados, um por semente (padrao %d)\n"
+            "  --first N          primeira semente (padrao 1)\n"
+            "  --runs N           corridas de bot por nivel (padrao %d)\n"
+            "  --threads N        threads de trabalho (padrao: todos os nucleos)\n"
+            "  --csv arquivo      grava a tabela completa em CSV\n"
+            "  --pack arquivo N   grava um pacote de N niveis ordenados por dificuldade\n",
+            program, DIFFICULTY_DEFAULT_SEEDS, DIFFICULTY_DEFAULT_RUNS);
+}
+
+int main(int argc, char** argv) {
+    uint32_t seeds = DIFFICULTY_DEFAULT_SEEDS, first_seed = 1, runs = DIFFICULTY_DEFAULT_RUNS, pack_size = 0;
+    const char* csv_path = NULL;
+    const char* pack_path = NULL;
+
+    gThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seeds") && i + 1 < argc) { seeds = strtoul(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--first") && i + 1 < argc) { first_seed = strtoul(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--runs") && i + 1 < argc) { runs = strtoul(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) { gThreads = atoi(argv[++i]); }
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc) { csv_path = argv[++i]; }
+        else if (!strcmp(argv[i], "--pack") && i + 2 < argc) { pack_path = argv[++i]; pack_size = strtoul(argv[++i], NULL, 0); }
+        else { Usage(argv[0]); return 2; }
+    }
+    if (seeds == 0 || runs == 0) { Usage(argv[0]); return 2; }
+    if (gThreads < 1) gThreads = 1;
+    if (gThreads > DIFFICULTY_MAX_THREADS) gThreads = DIFFICULTY_MAX_THREADS;
+
+    gLevelCount = seeds;
+    gLevels = calloc(seeds, sizeof(*gLevels));
+    uint32_t batches = (runs + DIFFICULTY_BATCH_RUNS - 1) / DIFFICULTY_BATCH_RUNS;
+    uint32_t task_count = seeds * batches;
+    gTasks = malloc(task_count * sizeof(*gTasks));
+    if (!gLevels || !gTasks) { fprintf(stderr, "memoria insuficiente\n"); return 1; }
+
+    for (uint32_t i = 0; i < seeds; i++) {
+        gLevels[i].seed = first_seed + i;
+        pthread_mutex_init(&gLevels[i].lock, NULL);
+    }
+    // Tarefas intercaladas por nível: a fatia inicial de cada thread mistura níveis fáceis e difíceis
+    for (uint32_t t = 0; t < task_count; t++) {
+        uint32_t batch = t / seeds;
+        uint32_t first = batch * DIFFICULTY_BATCH_RUNS;
+        gTasks[t] = (DIFFICULTY_TASK_t){ .level = t % seeds, .first_run = first,
+                                         .runs = runs - first < DIFFICULTY_BATCH_RUNS ? runs - first : DIFFICULTY_BATCH_RUNS };
+    }
+    for (int t = 0; t < gThreads; t++) pthread_mutex_init(&gDeques[t].lock, NULL);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RunPhase(seeds, GenerateLevel);
+    double generate_s = Seconds(&start);
+
+    for (int t = 0; t < gThreads; t++) { gDeques[t].executed = 0; gDeques[t].stolen = 0; }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RunPhase(task_count, RunBatch);
+    double run_s = Seconds(&start);
+
+    PrintTable();
+    PrintBeam();
+    printf("\n%lu niveis gerados em %.2f s; %llu corridas em %.2f s (%.0f corridas/s, %d threads)\n",
+           (unsigned long)seeds, generate_s, (unsigned long long)seeds * runs, run_s,
+           run_s > 0 ? seeds * (double)runs / run_s : 0.0, gThreads);
+    for (int t = 0; t < gThreads; t++) {
+        printf("  thread %2d: %6lu tarefas, %6lu roubadas\n", t,
+               (unsigned long)gDeques[t].executed, (unsigned long)gDeques[t].stolen);
+    }
+
+    if (csv_path && !WriteCsv(csv_path)) { fprintf(stderr, "nao foi possivel gravar %s\n", csv_path); return 1; }
+    if (pack_path && !WritePack(pack_path, pack_size)) { fprintf(stderr, "nao foi possivel gravar %s\n", pack_path); return 1; }
+    return 0;
+}
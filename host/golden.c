@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "host_hal.h"
+#include "host_sim.h"
+#include <include/game.h>
+
+/****************************
+* DEFINES
+****************************/
+#define GOLDEN_PATH_MAX 512
+#define GOLDEN_ROW_BYTES (SCREEN_WIDTH / 8)
+#define GOLDEN_IMAGE_BYTES (GOLDEN_ROW_BYTES * SCREEN_HEIGHT)
+
+#define PRESS(ms, pin) { (uint64_t)(ms) * 1000, pin, false } // Botões são ativos em nível baixo
+#define RELEASE(ms, pin) { (uint64_t)(ms) * 1000, pin, true }
+#define A HOST_SIM_BUTTON_A_PIN
+#define B HOST_SIM_BUTTON_B_PIN
+
+#define NO_FORCED_STATE (-1)
+
+// Cena: roteiro de entradas a partir do reset, capturada no último quadro enviado até at_ms
+typedef struct
+{
+    const char* name;
+    unsigned seed;
+    int forced_state;                   // Estado imposto logo após o reset, ou NO_FORCED_STATE
+    const HOST_GPIO_EVENT_t* script;
+    size_t script_length;
+    uint32_t at_ms;
+}GOLDEN_SCENE_t;
+
+/****************************
+* ROTEIROS
+****************************/
+static const HOST_GPIO_EVENT_t script_config[] = {
+    PRESS(100, B), RELEASE(150, B)
+};
+
+// Sobe a velocidade duas vezes e segura B até a metade da barra de saída
+static const HOST_GPIO_EVENT_t script_config_hold[] = {
+    PRESS(100, B), RELEASE(150, B),
+    PRESS(400, A), RELEASE(450, A), PRESS(500, A), RELEASE(550, A),
+    PRESS(700, B)
+};
+
+static const HOST_GPIO_EVENT_t script_levels[] = {
+    PRESS(100, A), RELEASE(150, A)
+};
+
+static const HOST_GPIO_EVENT_t script_levels_right[] = {
+    PRESS(100, A), RELEASE(150, A),
+    PRESS(400, B), RELEASE(1300, B)
+};
+
+static const HOST_GPIO_EVENT_t script_endless[] = {
+    PRESS(100, A), RELEASE(1200, A),
+    PRESS(1500, B), RELEASE(2700, B)
+};
+
+#define SCRIPT(s) s, sizeof(s) / sizeof(s[0])
+
+static const GOLDEN_SCENE_t scenes[] = {
+    { "menu",             1, NO_FORCED_STATE,              NULL, 0,                         0 },
+    { "menu-seed7",       7, NO_FORCED_STATE,              NULL, 0,                         0 },
+    { "config",           1, NO_FORCED_STATE,              SCRIPT(script_config),         300 },
+    { "config-hold",      1, NO_FORCED_STATE,              SCRIPT(script_config_hold),   1200 },
+    { "game-over",        1, GAME_STATE_GAME_OVER,         NULL, 0,                         0 },
+    { "level-complete",   1, GAME_STATE_LEVEL_COMPLETE,    NULL, 0,                         0 },
+    { "play-start",       1, NO_FORCED_STATE,              SCRIPT(script_levels),         300 },
+    { "play-1s",          1, NO_FORCED_STATE,              SCRIPT(script_levels),        1200 },
+    { "play-right",      10, NO_FORCED_STATE,              SCRIPT(script_levels_right),  1500 },
+    { "play-right-late", 10, NO_FORCED_STATE,              SCRIPT(script_levels_right),  2500 },
+    { "endless-start",   10, NO_FORCED_STATE,              SCRIPT(script_endless),       1200 },
+    { "endless-run",     10, NO_FORCED_STATE,              SCRIPT(script_endless),       2500 },
+    { "endless-late",    10, NO_FORCED_STATE,              SCRIPT(script_endless),       3500 },
+};
+
+/****************************
+* PBM
+****************************/
+
+// Converte o framebuffer em páginas do SSD1306 para linhas de 1 bit (P4: MSB à esquerda, 1 = aceso)
+static void FrameToRows(const uint8_t* frame, uint8_t* rows) {
+    memset(rows, 0, GOLDEN_IMAGE_BYTES);
+    for (int y = 0; y < SCREEN_HEIGHT; y++)
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+            if ((frame[x + SCREEN_WIDTH * (y >> 3)] >> (y & 7)) & 1)
+                rows[y * GOLDEN_ROW_BYTES + (x >> 3)] |= 0x80 >> (x & 7);
+}
+
+static bool WritePbm(const char* path, const uint8_t* rows) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    fprintf(file, "P4\n%d %d\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+    bool ok = fwrite(rows, 1, GOLDEN_IMAGE_BYTES, file) == GOLDEN_IMAGE_BYTES;
+
+    return fclose(file) == 0 && ok;
+}
+
+static bool ReadPbm(const char* path, uint8_t* rows) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    int width, height;
+    bool ok = fscanf(file, "P4 %d %d", &width, &height) == 2 &&
+              width == SCREEN_WIDTH && height == SCREEN_HEIGHT &&
+              fgetc(file) != EOF && // Um único espaço separa o cabeçalho dos dados
+              fread(rows, 1, GOLDEN_IMAGE_BYTES, file) == GOLDEN_IMAGE_BYTES;
+
+    fclose(file);
+    return ok;
+}
+
+/****************************
+* CENAS
+****************************/
+static void RenderScene(HOST_SIM_t* sim, const GOLDEN_SCENE_t* scene, uint8_t* rows) {
+    HOST_GPIO_SetScript(scene->script, scene->script_length);
+    HOST_SIM_Reset(sim, scene->seed);
+    if (scene->forced_state != NO_FORCED_STATE) gCurrentGameState = (GAME_STATE_t)scene->forced_state;
+
+    while (sim->ms <= scene->at_ms) HOST_SIM_Step(sim);
+
+    FrameToRows(HOST_I2C_GetStats()->frame, rows);
+}
+
+// Compara com o golden; em caso de divergência grava <cena>.actual.pbm e <cena>.diff.pbm (XOR)
+static bool CheckScene(const char* dir, const GOLDEN_SCENE_t* scene, const uint8_t* rows) {
+    char path[GOLDEN_PATH_MAX];
+    uint8_t golden[GOLDEN_IMAGE_BYTES];
+    uint8_t diff[GOLDEN_IMAGE_BYTES];
+
+    snprintf(path, sizeof(path), "%s/%s.pbm", dir, scene->name);
+    if (!ReadPbm(path, golden)) {
+        printf("FALHA %-16s golden ausente ou invalido: %s\n", scene->name, path);
+        return false;
+    }
+
+    int pixels = 0, x0 = SCREEN_WIDTH, y0 = SCREEN_HEIGHT, x1 = -1, y1 = -1;
+    for (int i = 0; i < GOLDEN_IMAGE_BYTES; i++) {
+        diff[i] = golden[i] ^ rows[i];
+        for (uint8_t bits = diff[i]; bits; bits &= bits - 1) {
+            int x = (i % GOLDEN_ROW_BYTES) * 8 + 7 - __builtin_ctz(bits); // MSB é o pixel mais à esquerda
+            int y = i / GOLDEN_ROW_BYTES;
+            pixels++;
+            if (x < x0) x0 = x;
+            if (x > x1) x1 = x;
+            if (y < y0) y0 = y;
+            if (y > y1) y1 = y;
+        }
+    }
+
+    if (!pixels) {
+        printf("ok    %s\n", scene->name);
+        return true;
+    }
+
+    printf("FALHA %-16s %d pixels diferentes em (%d,%d)-(%d,%d)\n", scene->name, pixels, x0, y0, x1, y1);
+    snprintf(path, sizeof(path), "%s/%s.actual.pbm", dir, scene->name);
+    WritePbm(path, rows);
+    snprintf(path, sizeof(path), "%s/%s.diff.pbm", dir, scene->name);
+    WritePbm(path, diff);
+
+    return false;
+}
+
+static void Usage(const char* program) {
+    fprintf(stderr,
+            "uso: %s record|check <diretorio>\n"
+            "  record  renderiza as cenas e grava <cena>.pbm no diretorio\n"
+            "  check   compara com os goldens; divergencias geram <cena>.actual.pbm e <cena>.diff.pbm\n",
+            program);
+}
+
+/****************************
+* MAIN
+****************************/
+int main(int argc, char** argv) {
+    if (argc != 3 || (strcmp(argv[1], "record") && strcmp(argv[1], "check"))) {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    bool record = !strcmp(argv[1], "record");
+    const char* dir = argv[2];
+
+    if (record && mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "nao foi possivel criar %s\n", dir);
+        return 1;
+    }
+
+    HOST_SIM_t* sim = HOST_SIM_Init();
+    uint8_t rows[GOLDEN_IMAGE_BYTES];
+    int failures = 0;
+    int count = sizeof(scenes) / sizeof(scenes[0]);
+
+    for (int i = 0; i < count; i++) {
+        RenderScene(sim, &scenes[i], rows);
+
+        if (record) {
+            char path[GOLDEN_PATH_MAX];
+            snprintf(path, sizeof(path), "%s/%s.pbm", dir, scenes[i].name);
+            if (!WritePbm(path, rows)) { fprintf(stderr, "nao foi possivel gravar %s\n", path); failures++; }
+            else printf("gravado %s\n", path);
+        } else if (!CheckScene(dir, &scenes[i], rows)) {
+            failures++;
+        }
+    }
+
+    HOST_GPIO_SetScript(NULL, 0);
+    printf("%d/%d cenas %s\n", count - failures, count, record ? "gravadas" : "identicas");
+
+    return failures ? 1 : 0;
+}
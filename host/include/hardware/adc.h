@@ -0,0 +1,4 @@
+#ifndef _HOST_HARDWARE_ADC_H
+#define _HOST_HARDWARE_ADC_H
+
+#endif
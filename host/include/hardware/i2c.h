@@ -0,0 +1,6 @@
+#ifndef _HOST_HARDWARE_I2C_H
+#define _HOST_HARDWARE_I2C_H
+
+typedef struct i2c_inst i2c_inst_t;
+
+#endif
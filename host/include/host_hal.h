@@ -0,0 +1,58 @@
+#ifndef _HOST_HAL_H
+#define _HOST_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HOST_GPIO_PINS 30
+#define HOST_ADC_CHANNELS 4
+#define HOST_I2C_LOG_SIZE 64
+#define HOST_I2C_FRAME_SIZE 1024
+
+// Transação I2C gravada pelo substituto de I2C_t
+typedef struct
+{
+    uint64_t time_us;
+    uint8_t address;
+    uint8_t first_byte;     // 0x00 = comando, 0x40 = dados para a RAM do display
+    bool write;
+    size_t length;
+}HOST_I2C_RECORD_t;
+
+typedef struct
+{
+    uint32_t transactions;
+    uint32_t frames;        // Escritas de dados com um framebuffer inteiro
+    uint64_t bytes;
+    HOST_I2C_RECORD_t log[HOST_I2C_LOG_SIZE];   // Anel com as transações mais recentes
+    uint8_t frame[HOST_I2C_FRAME_SIZE];         // Último framebuffer transmitido
+}HOST_I2C_STATS_t;
+
+// Evento do roteiro de entradas: no instante time_us o pino passa para level
+typedef struct
+{
+    uint64_t time_us;
+    uint8_t pin;
+    bool level;
+}HOST_GPIO_EVENT_t;
+
+void HOST_TimeAdvance( uint64_t );
+
+void HOST_TimeReset( void );
+
+const HOST_I2C_STATS_t* HOST_I2C_GetStats( void );
+
+void HOST_I2C_Reset( void );
+
+void HOST_GPIO_SetLevel( uint8_t , bool );
+
+bool HOST_GPIO_LoadScript( const char* );
+
+void HOST_GPIO_SetScript( const HOST_GPIO_EVENT_t* , size_t );
+
+void HOST_GPIO_Update( void );
+
+void HOST_ADC_SetValue( uint8_t , uint16_t );
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _HOST_SIM_H
+#define _HOST_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <include/driver1306.h>
+#include <include/gpio.h>
+#include <include/replay.h>
+
+#define HOST_SIM_BUTTON_A_PIN 5 // Mesmos pinos de main.c
+#define HOST_SIM_BUTTON_B_PIN 6
+
+// Escalonador simulado: substitui as quatro tarefas de main.c por um laço em passos de 1 ms
+typedef struct
+{
+    D1306_t* display;
+    GPIO_t* button_a;
+    GPIO_t* button_b;
+    uint64_t ms;            // Milissegundos simulados desde HOST_SIM_Reset
+    bool render;            // false pula GAME_Render/D1306_Show (execuções só de lógica)
+    REPLAY_t* record;       // Se definido, grava cada amostra dos botões
+    REPLAY_t* replay;       // Se definido, os botões vêm do fluxo gravado em vez dos GPIOs
+}HOST_SIM_t;
+
+HOST_SIM_t* HOST_SIM_Init( void );
+
+void HOST_SIM_Reset( HOST_SIM_t* , unsigned );
+
+void HOST_SIM_Step( HOST_SIM_t* );
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef _HOST_PICO_STDLIB_H
+#define _HOST_PICO_STDLIB_H
+
+// Substituto mínimo do Pico SDK para a compilação no host
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/time.h"
+
+typedef unsigned int uint;
+
+bool stdio_init_all( void );
+
+// Como na placa: imprime a mensagem e para (aqui, encerra o processo)
+void panic( const char* , ... ) __attribute__(( noreturn ));
+
+#endif
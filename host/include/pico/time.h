@@ -0,0 +1,13 @@
+#ifndef _HOST_PICO_TIME_H
+#define _HOST_PICO_TIME_H
+
+#include <stdint.h>
+
+// Tempo simulado: só avança via HOST_TimeAdvance ou sleep_*
+uint64_t time_us_64( void );
+
+void sleep_ms( uint32_t );
+
+void sleep_us( uint64_t );
+
+#endif
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include "host_sim.h"
+#include <include/game.h>
+
+/****************************
+* DEFINES
+****************************/
+#define DEFAULT_DURATION_MS 60000
+#define REPLAY_CAPACITY (64 * 1024) // ~4 mil corridas: horas de jogo com entradas típicas
+
+static const char* state_names[] = { "MENU", "PLAY", "CONFIG", "GAME_OVER", "LEVEL_COMPLETE" };
+
+static double WallSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool SaveReplay(const char* path, const REPLAY_t* replay) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(replay->data, 1, replay->size, file) == replay->size;
+    return fclose(file) == 0 && ok;
+}
+
+static bool LoadReplay(const char* path, REPLAY_t* replay) {
+    static uint8_t data[REPLAY_CAPACITY];
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    return REPLAY_Load(replay, data, size);
+}
+
+// FNV-1a do último quadro e do estado final: duas execuções iguais dão a mesma assinatura
+static uint32_t RunSignature(void) {
+    const HOST_I2C_STATS_t* i2c = HOST_I2C_GetStats();
+    int state[] = { gCurrentGameState, gGameMode, gPlayerPos[0], gPlayerPos[1], gCameraX };
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < sizeof(i2c->frame); i++) hash = (hash ^ i2c->frame[i]) * 16777619u;
+    for (size_t i = 0; i < sizeof(state); i++) hash = (hash ^ ((const uint8_t*)state)[i]) * 16777619u;
+
+    return hash;
+}
+
+static void Usage(const char* program) {
+    fprintf(stderr,
+            "uso: %s [--seed N] [--ms N] [--script arquivo] [--record arquivo | --replay arquivo]\n"
+            "  --seed N           semente dos níveis e de rand() (padrão 1)\n"
+            "  --ms N             duração simulada em ms (padrão %d, ou o fluxo inteiro com --replay)\n"
+            "  --script arquivo   roteiro de entradas \"<tempo_ms> <pino> <nível>\"\n"
+            "  --record arquivo   grava semente e botões amostrados para reprodução exata\n"
+            "  --replay arquivo   reproduz uma gravação (ignora --seed e --script)\n",
+            program, DEFAULT_DURATION_MS);
+}
+
+/****************************
+* MAIN
+****************************/
+int main(int argc, char** argv) {
+    unsigned seed = 1;
+    uint64_t duration_ms = 0;
+    const char* script = NULL;
+    const char* record = NULL;
+    const char* replay = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seed") && i + 1 < argc) { seed = strtoul(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--ms") && i + 1 < argc) { duration_ms = strtoull(argv[++i], NULL, 0); }
+        else if (!strcmp(argv[i], "--script") && i + 1 < argc) { script = argv[++i]; }
+        else if (!strcmp(argv[i], "--record") && i + 1 < argc) { record = argv[++i]; }
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) { replay = argv[++i]; }
+        else { Usage(argv[0]); return 2; }
+    }
+    if (record && replay) { Usage(argv[0]); return 2; }
+
+    if (script && !HOST_GPIO_LoadScript(script)) {
+        fprintf(stderr, "nao foi possivel abrir %s\n", script);
+        return 1;
+    }
+
+    HOST_SIM_t* sim = HOST_SIM_Init();
+    if (record) sim->record = REPLAY_Init(REPLAY_CAPACITY);
+    if (replay) {
+        sim->replay = REPLAY_Init(REPLAY_CAPACITY);
+        if (!LoadReplay(replay, sim->replay)) {
+            fprintf(stderr, "gravacao invalida: %s\n", replay);
+            return 1;
+        }
+        if (!duration_ms) duration_ms = (uint64_t)REPLAY_GetSamples(sim->replay) * GAME_INPUT_PERIOD_MS;
+    }
+    if (!duration_ms) duration_ms = DEFAULT_DURATION_MS;
+    HOST_SIM_Reset(sim, seed);
+
+    uint32_t transitions = 0;
+    uint32_t state_entries[GAME_STATE_LEVEL_COMPLETE + 1] = { 0 };
+    GAME_STATE_t last_state = gCurrentGameState;
+    double wall_start = WallSeconds();
+
+    while (sim->ms < duration_ms) {
+        HOST_SIM_Step(sim);
+
+        if (gCurrentGameState != last_state) {
+            transitions++;
+            state_entries[gCurrentGameState]++;
+            last_state = gCurrentGameState;
+        }
+    }
+
+    double wall = WallSeconds() - wall_start;
+    const HOST_I2C_STATS_t* i2c = HOST_I2C_GetStats();
+
+    printf("simulado: %llu ms em %.3f s (%.0fx tempo real)\n",
+           (unsigned long long)duration_ms, wall, wall > 0 ? duration_ms / 1000.0 / wall : 0.0);
+    printf("estado final: %s, transicoes: %u, game over: %u, niveis completos: %u\n",
+           state_names[gCurrentGameState], transitions,
+           state_entries[GAME_STATE_GAME_OVER], state_entries[GAME_STATE_LEVEL_COMPLETE]);
+    printf("i2c: %u transacoes, %llu bytes, %u quadros\n",
+           i2c->transactions, (unsigned long long)i2c->bytes, i2c->frames);
+    printf("assinatura: %08x\n", RunSignature());
+
+    if (record) {
+        if (!SaveReplay(record, sim->record)) { fprintf(stderr, "nao foi possivel gravar %s\n", record); return 1; }
+        printf("gravacao: %s, semente %u, %u amostras em %zu bytes\n",
+               record, sim->record->seed, REPLAY_GetSamples(sim->record), sim->record->size);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include <include/stats.h>
+
+/****************************
+* DEFINES
+****************************/
+#define DEFAULT_DURATION_MS 10000
+#define MONITOR_PRIORITY ( configMAX_PRIORITIES - 2 ) // Acima das tarefas do jogo, abaixo do daemon de timers
+#define STATS_BUFFER_SIZE 2048
+
+int CHAOS_Main( void ); // main() de main.c, compilado com -Dmain=CHAOS_Main
+
+/****************************
+* VARIABLES
+****************************/
+static uint64_t gDurationMs = DEFAULT_DURATION_MS;
+static struct timespec gWallStart;
+
+/****************************
+* HOOKS DO FREERTOS
+****************************/
+
+// O relógio simulado anda exatamente 1 ms por tick: o jogo vê o mesmo tempo a cada execução,
+// independente da carga do PC. O roteiro de entradas avança junto.
+void vApplicationTickHook( void ) {
+    HOST_TimeAdvance( 1000000 / configTICK_RATE_HZ );
+    HOST_GPIO_Update();
+}
+
+// Contador das estatísticas de execução: microssegundos reais desde o início
+unsigned long HOST_RunTimeCounter( void ) {
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( unsigned long )( ( now.tv_sec - gWallStart.tv_sec ) * 1000000L + ( now.tv_nsec - gWallStart.tv_nsec ) / 1000 );
+}
+
+/****************************
+* TASKS
+****************************/
+
+// Ao fim da duração simulada, imprime tempo de CPU e estado de cada tarefa e encerra
+void TASK_Monitor() {
+    static char stats[STATS_BUFFER_SIZE];
+
+    vTaskDelay( pdMS_TO_TICKS( gDurationMs ) );
+
+    vTaskSuspendAll();
+    printf( "\nsimulado: %llu ms\n", ( unsigned long long )( time_us_64() / 1000 ) );
+
+    vTaskGetRunTimeStats( stats );
+    printf( "Tarefa\t\tTempo (us)\t%%\n%s", stats );
+
+    vTaskList( stats );
+    printf( "\nTarefa\t\tEstado\tPrio\tPilha livre\tNum\n%s", stats );
+
+    STATS_PrintHeap();
+
+    const HOST_I2C_STATS_t* i2c = HOST_I2C_GetStats();
+    printf( "\ni2c: %u transacoes, %llu bytes, %u quadros\n",
+            i2c->transactions, ( unsigned long long )i2c->bytes, i2c->frames );
+
+    fflush( stdout );
+    exit( 0 );
+}
+
+static void Usage( const char* program ) {
+    fprintf( stderr,
+             "uso: %s [--seed N] [--ms N] [--script arquivo]\n"
+             "  --seed N          relogio simulado no boot em us (main.c faz srand(time_us_64()))\n"
+             "  --ms N            duracao simulada em ms (padrao %d)\n"
+             "  --script arquivo  roteiro de entradas \"<tempo_ms> <pino> <nivel>\"\n",
+             program, DEFAULT_DURATION_MS );
+}
+
+/****************************
+* MAIN
+****************************/
+int main( int argc, char** argv ) {
+    uint64_t seed = 0;
+    const char* script = NULL;
+
+    for( int i = 1; i < argc; i++ ) {
+        if( !strcmp( argv[i], "--seed" ) && i + 1 < argc ) { seed = strtoull( argv[++i], NULL, 0 ); }
+        else if( !strcmp( argv[i], "--ms" ) && i + 1 < argc ) { gDurationMs = strtoull( argv[++i], NULL, 0 ); }
+        else if( !strcmp( argv[i], "--script" ) && i + 1 < argc ) { script = argv[++i]; }
+        else { Usage( argv[0] ); return 2; }
+    }
+
+    if( script && !HOST_GPIO_LoadScript( script ) ) {
+        fprintf( stderr, "nao foi possivel abrir %s\n", script );
+        return 1;
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &gWallStart );
+    HOST_TimeReset();
+    HOST_TimeAdvance( seed );
+
+    // As tarefas do jogo são exatamente as de main.c; o monitor só observa
+    xTaskCreate( TASK_Monitor, "Monitor", 1024, NULL, MONITOR_PRIORITY, NULL );
+    return CHAOS_Main();
+}
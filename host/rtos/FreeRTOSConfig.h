@@ -0,0 +1,118 @@
+/*
+ * Configuração do FreeRTOS para o port POSIX/Linux (build de host com CHAOS_HOST_RTOS).
+ * Espelha include/FreeRTOSConfig.h da placa onde faz sentido, para que prioridades,
+ * períodos e heap se comportem como no RP2040; o que é específico do RP2040 foi removido.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Scheduler Related */
+#define configUSE_PREEMPTION                    1
+#define configUSE_TICKLESS_IDLE                 0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     1   /* Avança o relógio simulado a cada tick */
+#define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                    32
+#define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 256
+#define configUSE_16_BIT_TICKS                  0
+
+#define configIDLE_SHOULD_YIELD                 1
+
+/* Synchronization Related */
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_APPLICATION_TASK_TAG          0
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configQUEUE_REGISTRY_SIZE               8
+#define configUSE_QUEUE_SETS                    1
+#define configUSE_TIME_SLICING                  1
+#define configUSE_NEWLIB_REENTRANT              0
+#define configENABLE_BACKWARD_COMPATIBILITY     1
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+
+/* System */
+#define configSTACK_DEPTH_TYPE                  uint32_t
+#define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
+
+/* Memory allocation related definitions. */
+#ifndef CHAOS_STATIC_ALLOC
+#define CHAOS_STATIC_ALLOC                      0
+#endif
+
+#if CHAOS_STATIC_ALLOC
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configTOTAL_HEAP_SIZE                   (8*1024)
+#else
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configTOTAL_HEAP_SIZE                   (128*1024)
+#endif
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configAPPLICATION_ALLOCATED_HEAP        0
+
+/* Hook function related definitions. */
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_MALLOC_FAILED_HOOK            1
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+
+/* Run time and task stats gathering related definitions. */
+/* Aqui as estatísticas ficam sempre ligadas; CHAOS_TASK_STATS só decide se main.c cria TASK_Stats */
+#ifndef CHAOS_TASK_STATS
+#define CHAOS_TASK_STATS                        0
+#endif
+/* O trace (CHAOS_TRACE) só existe na placa; aqui fica desligado */
+#ifndef CHAOS_TRACE
+#define CHAOS_TRACE                             0
+#endif
+/* CHAOS_POWER_SAVE muda só main.c: o port POSIX não tem tickless idle */
+#ifndef CHAOS_POWER_SAVE
+#define CHAOS_POWER_SAVE                        0
+#endif
+/* O contador usa o relógio real do PC: mede quanto cada tarefa custa no host, não o tempo simulado */
+extern unsigned long HOST_RunTimeCounter( void );
+#define configGENERATE_RUN_TIME_STATS           1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        HOST_RunTimeCounter()
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+
+/* Co-routine related definitions. */
+#define configUSE_CO_ROUTINES                   0
+#define configMAX_CO_ROUTINE_PRIORITIES         1
+
+/* Software timer related definitions. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            1024
+
+#include <assert.h>
+/* Define to trap errors during development. */
+#define configASSERT(x)                         assert(x)
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_eTaskGetState                   1
+#define INCLUDE_xTimerPendFunctionCall          1
+#define INCLUDE_xTaskAbortDelay                 1
+#define INCLUDE_xTaskGetHandle                  1
+#define INCLUDE_xTaskResumeFromISR              1
+#define INCLUDE_xQueueGetMutexHolder            1
+
+/* Como na placa: alocações do heap somadas por tarefa (src/stats.c) */
+extern void STATS_TraceMalloc( void * pvAddress, size_t uiSize );
+#define traceMALLOC( pvAddress, uiSize )        STATS_TraceMalloc( pvAddress, uiSize )
+extern void STATS_TaskSwitchedIn( void );
+#define traceTASK_SWITCHED_IN()                 STATS_TaskSwitchedIn()
+
+#endif /* FREERTOS_CONFIG_H */
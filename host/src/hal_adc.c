@@ -0,0 +1,30 @@
+#include "adc.h"
+#include "host_hal.h"
+#include "alloc.h"
+
+// Substituto de ADC_t: cada canal devolve o último valor definido pelo host
+static uint16_t host_adc_value[HOST_ADC_CHANNELS];
+
+ADC_t* ADC_Init( ADC_CONFIG_t cfg )
+{
+    ADC_t* adc;
+
+    adc = (ADC_t*)HAL_Malloc( sizeof ( ADC_t ) , HAL_ALLOC_ADC );
+
+    assert( adc != NULL );
+    assert( cfg.pin >= 26 && cfg.pin <= 29 );
+
+    adc->channel = cfg.pin - 26;
+
+    return adc;
+}
+
+uint16_t ADC_ReadValue( ADC_t* adc )
+{
+    return host_adc_value[adc->channel];
+}
+
+void HOST_ADC_SetValue( uint8_t channel , uint16_t value )
+{
+    if( channel < HOST_ADC_CHANNELS ) host_adc_value[channel] = value;
+}
@@ -0,0 +1,124 @@
+#include "gpio.h"
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include "alloc.h"
+#include <stdio.h>
+#include <string.h>
+
+// Substituto de GPIO_t: níveis dos pinos em memória, alimentados por um roteiro de eventos
+static bool host_gpio_level[HOST_GPIO_PINS];
+static bool host_gpio_irq[HOST_GPIO_PINS];
+static GPIO_CALLBACK_t host_gpio_callback;
+
+static HOST_GPIO_EVENT_t* host_script = NULL;
+static size_t host_script_length = 0;
+static size_t host_script_next = 0;
+
+GPIO_t* GPIO_Init( GPIO_CONFIG_t cfg )
+{
+    GPIO_t* gpio;
+
+    gpio = (GPIO_t*)HAL_Malloc( sizeof ( GPIO_t ) , HAL_ALLOC_GPIO );
+
+    assert( gpio != NULL );
+    assert( cfg.pin >= 0 && cfg.pin < HOST_GPIO_PINS );
+
+    gpio->pin = cfg.pin;
+    gpio->logic = cfg.logic;
+
+    // Entrada em repouso segue o pull configurado
+    if( !cfg.direction ) host_gpio_level[gpio->pin] = cfg.mode ? true : false;
+
+    return gpio;
+}
+
+void GPIO_SetOutput( GPIO_t* gpio , bool value )
+{
+    host_gpio_level[gpio->pin] = gpio->logic ? value : !value;
+}
+
+void GPIO_ToogleOutput( GPIO_t* gpio )
+{
+    host_gpio_level[gpio->pin] = !host_gpio_level[gpio->pin];
+}
+
+bool GPIO_GetInput( GPIO_t* gpio )
+{
+    return gpio->logic ? host_gpio_level[gpio->pin] : !host_gpio_level[gpio->pin];
+}
+
+void GPIO_SetIrq( GPIO_t* gpio , bool enabled , GPIO_CALLBACK_t callback )
+{
+    host_gpio_callback = callback;
+    host_gpio_irq[gpio->pin] = enabled;
+}
+
+// Com a interrupção ligada, uma mudança de nível chama o callback (no host, de dentro do tick)
+void HOST_GPIO_SetLevel( uint8_t pin , bool level )
+{
+    if( pin >= HOST_GPIO_PINS ) return;
+
+    bool changed = host_gpio_level[pin] != level;
+    host_gpio_level[pin] = level;
+    if( changed && host_gpio_irq[pin] && host_gpio_callback ) host_gpio_callback();
+}
+
+void HOST_GPIO_SetScript( const HOST_GPIO_EVENT_t* events , size_t length )
+{
+    free( host_script );
+    host_script = NULL;
+    host_script_length = 0;
+    host_script_next = 0;
+
+    if( !length ) return;
+
+    host_script = (HOST_GPIO_EVENT_t*)malloc( length * sizeof( HOST_GPIO_EVENT_t ) );
+    assert( host_script != NULL );
+    memcpy( host_script , events , length * sizeof( HOST_GPIO_EVENT_t ) );
+    host_script_length = length;
+}
+
+// Formato: uma linha "<tempo_ms> <pino> <nível>" por evento, em ordem crescente de tempo; '#' comenta
+bool HOST_GPIO_LoadScript( const char* path )
+{
+    FILE* file = fopen( path , "r" );
+    if( !file ) return false;
+
+    HOST_GPIO_EVENT_t* events = NULL;
+    size_t length = 0 , capacity = 0;
+    char line[128];
+
+    while( fgets( line , sizeof( line ) , file ) )
+    {
+        unsigned long long time_ms;
+        unsigned pin , level;
+
+        if( line[0] == '#' || sscanf( line , "%llu %u %u" , &time_ms , &pin , &level ) != 3 ) continue;
+
+        if( length == capacity )
+        {
+            capacity = capacity ? capacity * 2 : 32;
+            events = (HOST_GPIO_EVENT_t*)realloc( events , capacity * sizeof( HOST_GPIO_EVENT_t ) );
+            assert( events != NULL );
+        }
+        events[length++] = (HOST_GPIO_EVENT_t){ .time_us = time_ms * 1000 , .pin = pin , .level = level != 0 };
+    }
+
+    fclose( file );
+    HOST_GPIO_SetScript( events , length );
+    free( events );
+
+    return true;
+}
+
+// Aplica todos os eventos do roteiro cujo instante já passou no tempo simulado
+void HOST_GPIO_Update( void )
+{
+    uint64_t now_us = time_us_64();
+
+    while( host_script_next < host_script_length && host_script[host_script_next].time_us <= now_us )
+    {
+        HOST_GPIO_SetLevel( host_script[host_script_next].pin , host_script[host_script_next].level );
+        host_script_next++;
+    }
+}
@@ -0,0 +1,78 @@
+#include "i2c.h"
+#include "host_hal.h"
+#include "alloc.h"
+#include <string.h>
+
+// Substituto de I2C_t: nenhuma linha física, cada escrita/leitura é gravada em memória
+static HOST_I2C_STATS_t host_i2c;
+
+static void HOST_I2C_Record( I2C_t* i2c , const char* buffer , size_t length , bool write )
+{
+    HOST_I2C_RECORD_t* record = &host_i2c.log[host_i2c.transactions % HOST_I2C_LOG_SIZE];
+
+    record->time_us = time_us_64();
+    record->address = i2c->address;
+    record->first_byte = length ? (uint8_t)buffer[0] : 0;
+    record->write = write;
+    record->length = length;
+
+    host_i2c.transactions++;
+    host_i2c.bytes += length;
+
+    // Byte de controle 0x40 seguido do buffer inteiro: um quadro do SSD1306
+    if( write && length == HOST_I2C_FRAME_SIZE + 1 && record->first_byte == 0x40 )
+    {
+        memcpy( host_i2c.frame , buffer + 1 , HOST_I2C_FRAME_SIZE );
+        host_i2c.frames++;
+    }
+}
+
+I2C_t* I2C_Init( I2C_CONFIG_t cfg )
+{
+    I2C_t* i2c;
+
+    i2c = (I2C_t*)HAL_Malloc( sizeof ( I2C_t ) , HAL_ALLOC_I2C );
+
+    assert( i2c != NULL );
+
+    i2c->address = cfg.address;
+    i2c->i2c_hw = NULL;
+
+    return i2c;
+}
+
+size_t I2C_WriteByte( I2C_t* i2c , char buffer )
+{
+    HOST_I2C_Record( i2c , &buffer , 1 , true );
+    return true;
+}
+
+size_t I2C_ReadByte( I2C_t* i2c , char* buffer )
+{
+    *buffer = 0;
+    HOST_I2C_Record( i2c , buffer , 1 , false );
+    return true;
+}
+
+size_t I2C_WriteByteArray( I2C_t* i2c , char* buffer , size_t length )
+{
+    HOST_I2C_Record( i2c , buffer , length , true );
+    return true;
+}
+
+size_t I2C_ReadByteArray( I2C_t* i2c , char* buffer , size_t length)
+{
+    memset( buffer , 0 , length );
+    HOST_I2C_Record( i2c , buffer , length , false );
+    return true;
+}
+
+const HOST_I2C_STATS_t* HOST_I2C_GetStats( void )
+{
+    return &host_i2c;
+}
+
+void HOST_I2C_Reset( void )
+{
+    memset( &host_i2c , 0 , sizeof( host_i2c ) );
+}
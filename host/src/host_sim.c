@@ -0,0 +1,79 @@
+#include "host_sim.h"
+#include "host_hal.h"
+#include "pico/stdlib.h"
+#include <include/game.h>
+#include <stdlib.h>
+#include <assert.h>
+
+HOST_SIM_t* HOST_SIM_Init( void )
+{
+    HOST_SIM_t* sim;
+
+    sim = (HOST_SIM_t*)malloc( sizeof ( HOST_SIM_t ) );
+
+    assert( sim != NULL );
+
+    // Mesma sequência de inicialização das tarefas em main.c, mas sobre o HAL simulado
+    D1306_CONFIG_t cfg = {
+        .external_vcc = false, .width = SCREEN_WIDTH, .height = SCREEN_HEIGHT,
+        .i2c_cfg.address = 0x3C, .i2c_cfg.frequency = 400 * 1000,
+        .i2c_cfg.i2c_id = 1, .i2c_cfg.pin_sda = 14, .i2c_cfg.pin_sdl = 15
+    };
+    sim->display = D1306_Init( cfg );
+    sim->button_a = GPIO_Init( (GPIO_CONFIG_t){ .pin = HOST_SIM_BUTTON_A_PIN , .direction = 0 , .logic = 1 , .mode = 1 } );
+    sim->button_b = GPIO_Init( (GPIO_CONFIG_t){ .pin = HOST_SIM_BUTTON_B_PIN , .direction = 0 , .logic = 1 , .mode = 1 } );
+    sim->render = true;
+    sim->record = NULL;
+    sim->replay = NULL;
+
+    HOST_SIM_Reset( sim , 1 );
+
+    return sim;
+}
+
+// Religa a placa simulada: relógio, barramento, botões soltos e jogo no menu com a semente dada.
+// O roteiro de entradas é mantido; quem chama define um novo com HOST_GPIO_SetScript se quiser.
+// Em reprodução, vale a semente gravada no fluxo.
+void HOST_SIM_Reset( HOST_SIM_t* sim , unsigned seed )
+{
+    if( sim->replay ) { seed = sim->replay->seed; REPLAY_Rewind( sim->replay ); }
+    if( sim->record ) REPLAY_Start( sim->record , seed );
+
+    HOST_TimeReset();
+    HOST_I2C_Reset();
+    HOST_GPIO_SetLevel( HOST_SIM_BUTTON_A_PIN , true );
+    HOST_GPIO_SetLevel( HOST_SIM_BUTTON_B_PIN , true );
+
+    srand( seed );
+    GAME_Init( seed );
+    D1306_Clear( sim->display );
+    sim->ms = 0;
+}
+
+// Avança 1 ms; cada tarefa roda quando seu período vence
+void HOST_SIM_Step( HOST_SIM_t* sim )
+{
+    HOST_GPIO_Update();
+    uint64_t now_us = time_us_64();
+
+    if( sim->ms % GAME_INPUT_PERIOD_MS == 0 )
+    {
+        uint8_t buttons = 0;
+        if( sim->replay )
+        {
+            REPLAY_Next( sim->replay , &buttons );
+        }else
+        {
+            if( !GPIO_GetInput( sim->button_a ) ) buttons |= REPLAY_BUTTON_A;
+            if( !GPIO_GetInput( sim->button_b ) ) buttons |= REPLAY_BUTTON_B;
+        }
+        if( sim->record ) REPLAY_Record( sim->record , buttons );
+
+        GAME_Input( buttons & REPLAY_BUTTON_A , buttons & REPLAY_BUTTON_B , now_us );
+    }
+    if( sim->ms % GAME_LOGIC_PERIOD_MS == 0 ) { GAME_StepPlatforms( now_us ); GAME_StepLogic(); }
+    if( sim->render && sim->ms % GAME_DISPLAY_PERIOD_MS == 0 ) { GAME_Render( sim->display , now_us ); D1306_Show( sim->display ); }
+
+    sim->ms++;
+    HOST_TimeAdvance( 1000 );
+}
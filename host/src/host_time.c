@@ -0,0 +1,49 @@
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+static uint64_t host_now_us = 0;
+
+bool stdio_init_all( void )
+{
+    return true;
+}
+
+void panic( const char* format , ... )
+{
+    va_list args;
+
+    va_start( args , format );
+    fputs( "panic: " , stderr );
+    vfprintf( stderr , format , args );
+    fputc( '\n' , stderr );
+    va_end( args );
+    abort();
+}
+
+uint64_t time_us_64( void )
+{
+    return host_now_us;
+}
+
+void sleep_ms( uint32_t ms )
+{
+    host_now_us += (uint64_t)ms * 1000;
+}
+
+void sleep_us( uint64_t us )
+{
+    host_now_us += us;
+}
+
+void HOST_TimeAdvance( uint64_t us )
+{
+    host_now_us += us;
+}
+
+void HOST_TimeReset( void )
+{
+    host_now_us = 0;
+}
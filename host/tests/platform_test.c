@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <include/platform.h>
+#include <include/random.h>
+
+/****************************
+* DEFINES
+****************************/
+#define TEST_PLATFORMS 48
+#define TEST_EPOCHS 12              // Rodadas de remoções e reinserções entre as conferências
+#define TEST_MAX_INTERVAL 255       // speed_interval cabe em 8 bits; a roda tem 256 slots
+#define TEST_MAX_TRAVEL 40
+#define TEST_MAX_ERRORS 20          // Depois disso só conta
+#define TEST_INDEX_OPS 4000         // Mudanças no índice, cada uma seguida de consultas
+#define TEST_INDEX_QUERIES 16
+#define TEST_WORLD_MIN ( -2 * PLATFORM_BUCKET_SPAN ) // Mundo mais largo que a grade: baldes com apelidos
+#define TEST_WORLD_SPAN ( 5 * PLATFORM_BUCKET_SPAN )
+#define TEST_WHEEL_MOVES ( 4 * PLATFORM_WHEEL_SLOTS )
+
+/****************************
+* VARIABLES
+****************************/
+// Os limites do jogo: tela de 64 linhas, reaparecimento 10 px fora dela
+static const PLATFORM_BOUNDS_t gBounds = { .top = 0, .bottom = 62, .reset_offset = 10 };
+
+static PLATFORMS_t gPlatforms;
+static PLATFORMS_t gSnapshot;
+static uint32_t gRandom;
+static unsigned long gErrors;
+static unsigned long gChecks;
+static bool gLive[PLATFORM_MAX_COUNT];     // Espelho do índice: plataformas não removidas
+
+/****************************
+* AUXILIARES
+****************************/
+static void Fail(const char* format, int i, unsigned long tick, long expected, long actual) {
+    if (gErrors++ < TEST_MAX_ERRORS) {
+        printf("FALHA ");
+        printf(format, i, tick);
+        printf(": esperado %ld, obtido %ld\n", expected, actual);
+    }
+}
+
+// Sorteia uma plataforma: fixa, travessia (lenta ou rápida) ou suavizada
+static PLATFORM_CONFIG_t RandomConfig(void) {
+    PLATFORM_CONFIG_t cfg = {
+        .x = (int16_t)RANDOM_Below(&gRandom, 1024), .y = (int16_t)RANDOM_Below(&gRandom, gBounds.bottom + 1),
+        .width = (uint8_t)(8 + RANDOM_Below(&gRandom, 24)), .height = 2,
+        .direction = RANDOM_Below(&gRandom, 2) ? DIR_DOWN : DIR_UP,
+    };
+    int kind = RANDOM_Below(&gRandom, 8);
+
+    cfg.is_moving = kind != 0;
+    cfg.speed_interval = (uint8_t)(kind == 1 ? 1 + RANDOM_Below(&gRandom, TEST_MAX_INTERVAL) : 1 + RANDOM_Below(&gRandom, 5));
+    if (kind >= 6) cfg.travel = (uint8_t)(1 + RANDOM_Below(&gRandom, TEST_MAX_TRAVEL));
+    return cfg;
+}
+
+// Maior período entre as plataformas vivas: depois dele toda altura já deu a volta
+static uint32_t LongestPeriod(const PLATFORMS_t* platforms) {
+    uint32_t longest = 1;
+    for (int i = 0; i < platforms->count; i++) {
+        if (!PLATFORMS_IsMoving(platforms, i)) continue;
+        uint32_t period = platforms->travel[i] ?
+            2u * platforms->travel[i] * platforms->speed_interval[i] :
+            (uint32_t)(gBounds.bottom - gBounds.top + platforms->height[i] + gBounds.reset_offset + PLATFORM_RESET_JITTER) * platforms->speed_interval[i];
+        if (period > longest) longest = period;
+    }
+    return longest;
+}
+
+/****************************
+* TESTES
+****************************/
+
+// PLATFORMS_YAt e PLATFORMS_NextStep contra o movimento de verdade: a cada rodada remove e
+// reinsere plataformas (inclusive em slots vivos, trocando o período), tira uma foto e anda
+// PLATFORMS_Move por um período completo, conferindo todo tick. A roda (wheel_tick) e as fases
+// das suavizadas dão várias voltas no caminho.
+static void TestLookahead(void) {
+    PLATFORMS_Clear(&gPlatforms);
+    gPlatforms.random = RANDOM_Seed(7);
+    for (int i = 0; i < TEST_PLATFORMS; i++) PLATFORMS_Add(&gPlatforms, RandomConfig());
+
+    for (int epoch = 0; epoch < TEST_EPOCHS; epoch++) {
+        for (int n = 0; n < TEST_PLATFORMS / 4; n++) {
+            int i = RANDOM_Below(&gRandom, TEST_PLATFORMS);
+            if (RANDOM_Below(&gRandom, 2)) PLATFORMS_Remove(&gPlatforms, i);
+            else PLATFORMS_Set(&gPlatforms, i, RandomConfig());
+        }
+        // Começa a rodada num ponto qualquer da roda
+        for (int n = RANDOM_Below(&gRandom, PLATFORM_WHEEL_SLOTS); n > 0; n--) PLATFORMS_Move(&gPlatforms, &gBounds);
+
+        memcpy(&gSnapshot, &gPlatforms, sizeof(gSnapshot));
+        uint32_t period = LongestPeriod(&gSnapshot) + PLATFORM_WHEEL_SLOTS;
+
+        for (uint32_t tick = 0; tick <= period; tick++) {
+            int16_t before[PLATFORM_MAX_COUNT];
+            int step[PLATFORM_MAX_COUNT];
+
+            for (int i = 0; i < gPlatforms.count; i++) {
+                int16_t predicted = PLATFORMS_YAt(&gSnapshot, &gBounds, i, tick);
+                if (predicted != gPlatforms.y[i]) Fail("YAt plataforma %d, tick %lu", i, tick, gPlatforms.y[i], predicted);
+                before[i] = gPlatforms.y[i];
+                step[i] = PLATFORMS_NextStep(&gPlatforms, i);
+                gChecks++;
+            }
+
+            PLATFORMS_Move(&gPlatforms, &gBounds);
+
+            for (int i = 0; i < gPlatforms.count; i++) {
+                int expected = gPlatforms.y[i] - before[i];
+                // O salto de quem dá a volta na tela não entra em NextStep: conta como um passo
+                if (!gPlatforms.travel[i] && (expected > 1 || expected < -1)) {
+                    expected = PLATFORMS_GetDirection(&gPlatforms, i) == DIR_DOWN ? 1 : -1;
+                }
+                if (step[i] != expected) Fail("NextStep plataforma %d, tick %lu", i, tick, expected, step[i]);
+            }
+        }
+    }
+}
+
+// Balde módulo a grade de cada coluna que o vão [x0, x1) cobre
+static void MarkBuckets(bool* marks, int x0, int x1) {
+    memset(marks, 0, PLATFORM_BUCKET_COUNT * sizeof(bool));
+    for (int c = x0 >> PLATFORM_BUCKET_SHIFT; c <= (x1 - 1) >> PLATFORM_BUCKET_SHIFT; c++) {
+        marks[c & (PLATFORM_BUCKET_COUNT - 1)] = true;
+        if (c - (x0 >> PLATFORM_BUCKET_SHIFT) >= PLATFORM_BUCKET_COUNT) break;
+    }
+}
+
+// Uma consulta contra a busca linear: toda plataforma viva que cruza o vão tem que vir, nenhuma
+// removida pode vir, e os candidatos extras só podem ser apelidos de um balde do vão
+static void CheckQuery(int x0, int x1) {
+    uint32_t found[PLATFORM_FLAG_WORDS];
+    bool query[PLATFORM_BUCKET_COUNT], span[PLATFORM_BUCKET_COUNT];
+
+    PLATFORMS_QuerySpan(&gPlatforms, (int16_t)x0, (int16_t)x1, found);
+    MarkBuckets(query, x0, x1);
+
+    for (int i = 0; i < PLATFORM_MAX_COUNT; i++) {
+        bool listed = (found[i >> 5] >> (i & 31)) & 1;
+        bool overlaps = gLive[i] && gPlatforms.x[i] < x1 && gPlatforms.x[i] + gPlatforms.width[i] > x0;
+        gChecks++;
+
+        if (overlaps && !listed) Fail("QuerySpan sem a plataforma %d, x0 %lu", i, (unsigned long)(x0 - TEST_WORLD_MIN), 1, 0);
+        if (!listed) continue;
+        if (!gLive[i]) { Fail("QuerySpan com a removida %d, x0 %lu", i, (unsigned long)(x0 - TEST_WORLD_MIN), 0, 1); continue; }
+
+        MarkBuckets(span, gPlatforms.x[i], gPlatforms.x[i] + gPlatforms.width[i]);
+        bool shared = false;
+        for (int b = 0; b < PLATFORM_BUCKET_COUNT; b++) shared |= query[b] && span[b];
+        if (!shared) Fail("QuerySpan com a plataforma %d fora dos baldes, x0 %lu", i, (unsigned long)(x0 - TEST_WORLD_MIN), 0, 1);
+    }
+}
+
+// PLATFORMS_FindSupport pelo índice contra a mesma regra aplicada a todas as plataformas vivas
+static void CheckSupport(int px, int py) {
+    const int pw = 4, ph = 4, gravity = 1;
+    int feet = py + ph, expected = PLATFORM_NONE;
+
+    for (int i = 0; i < gPlatforms.count; i++) {
+        if (!gLive[i] || px >= gPlatforms.x[i] + gPlatforms.width[i] || px + pw <= gPlatforms.x[i]) continue;
+        int top = gPlatforms.y[i];
+        if (feet >= top && feet <= top + gPlatforms.height[i] && feet + gravity > top) {
+            if (expected == PLATFORM_NONE || top < gPlatforms.y[expected]) expected = i;
+        }
+    }
+    int actual = PLATFORMS_FindSupport(&gPlatforms, (int16_t)px, (int16_t)py, pw, ph, gravity);
+    // Empate de altura: qualquer uma das duas serve
+    if (actual != expected && (actual == PLATFORM_NONE || expected == PLATFORM_NONE || gPlatforms.y[actual] != gPlatforms.y[expected])) {
+        Fail("FindSupport em x %d, y %lu", px, (unsigned long)py, expected, actual);
+    }
+    gChecks++;
+}
+
+// Baldes de colunas depois de PLATFORMS_SetX (dentro do balde e trocando de balde), Remove, Set
+// em slot livre ou vivo e ShiftX, num mundo mais largo que a grade
+static void TestIndex(void) {
+    PLATFORMS_Clear(&gPlatforms);
+    gPlatforms.random = RANDOM_Seed(11);
+    for (int i = 0; i < PLATFORM_MAX_COUNT; i++) {
+        PLATFORM_CONFIG_t cfg = RandomConfig();
+        cfg.x = (int16_t)(TEST_WORLD_MIN + RANDOM_Below(&gRandom, TEST_WORLD_SPAN));
+        cfg.width = (uint8_t)(1 + RANDOM_Below(&gRandom, 255));
+        PLATFORMS_Add(&gPlatforms, cfg);
+        gLive[i] = true;
+    }
+
+    for (int op = 0; op < TEST_INDEX_OPS; op++) {
+        int i = RANDOM_Below(&gRandom, PLATFORM_MAX_COUNT);
+        switch (RANDOM_Below(&gRandom, 8)) {
+            case 0:
+                PLATFORMS_Remove(&gPlatforms, i);
+                gLive[i] = false;
+                break;
+            case 1: {
+                PLATFORM_CONFIG_t cfg = RandomConfig();
+                cfg.x = (int16_t)(TEST_WORLD_MIN + RANDOM_Below(&gRandom, TEST_WORLD_SPAN));
+                cfg.width = (uint8_t)(1 + RANDOM_Below(&gRandom, 255));
+                PLATFORMS_Set(&gPlatforms, i, cfg);
+                gLive[i] = true;
+                break;
+            }
+            case 2:
+                if (gLive[i]) PLATFORMS_SetX(&gPlatforms, i, (int16_t)(TEST_WORLD_MIN + RANDOM_Below(&gRandom, TEST_WORLD_SPAN)));
+                break;
+            case 3:
+                if (op % 64 == 3) PLATFORMS_ShiftX(&gPlatforms, RANDOM_Below(&gRandom, 2) ? PLATFORM_BUCKET_SPAN : -PLATFORM_BUCKET_SPAN);
+                break;
+            default:
+                // Passos pequenos: a maioria não troca de balde. SetX só vale para plataformas vivas
+                if (gLive[i]) PLATFORMS_SetX(&gPlatforms, i, (int16_t)(gPlatforms.x[i] + RANDOM_Below(&gRandom, 7) - 3));
+                break;
+        }
+        for (int q = 0; q < TEST_INDEX_QUERIES; q++) {
+            int x0 = TEST_WORLD_MIN - PLATFORM_BUCKET_SPAN + RANDOM_Below(&gRandom, TEST_WORLD_SPAN + 2 * PLATFORM_BUCKET_SPAN);
+            CheckQuery(x0, x0 + 1 + RANDOM_Below(&gRandom, q == 0 ? 2 * PLATFORM_BUCKET_SPAN : 160));
+            CheckSupport(x0, RANDOM_Below(&gRandom, gBounds.bottom + 1) - 4);
+        }
+    }
+}
+
+// Roda de temporização: cada travessia anda exatamente a cada speed_interval chamadas de
+// PLATFORMS_Move desde que foi posta, com speed_interval de 1 a 255, a roda começando perto do
+// fim (os primeiros slots dão a volta) e vários giros completos. No meio, metade é reposta com
+// outro período em slot vivo e passa a contar dali.
+static void TestWheel(void) {
+    uint32_t anchor[PLATFORM_MAX_COUNT];
+    uint8_t interval[PLATFORM_MAX_COUNT];
+    int count = TEST_MAX_INTERVAL;
+
+    for (int start = PLATFORM_WHEEL_SLOTS - 8; start < PLATFORM_WHEEL_SLOTS + 8; start += 3) {
+        PLATFORMS_Clear(&gPlatforms);
+        gPlatforms.random = RANDOM_Seed(start);
+        for (int n = 0; n < start; n++) PLATFORMS_Move(&gPlatforms, &gBounds);
+
+        for (int i = 0; i < count; i++) {
+            PLATFORM_CONFIG_t cfg = { .x = (int16_t)(i * 4), .y = (int16_t)RANDOM_Below(&gRandom, gBounds.bottom + 1), .width = 4, .height = 2,
+                                      .is_moving = true, .direction = i & 1 ? DIR_DOWN : DIR_UP, .speed_interval = (uint8_t)(i + 1) };
+            PLATFORMS_Add(&gPlatforms, cfg);
+            anchor[i] = 0; interval[i] = cfg.speed_interval;
+        }
+
+        for (uint32_t move = 1; move <= TEST_WHEEL_MOVES; move++) {
+            int16_t before[PLATFORM_MAX_COUNT];
+            memcpy(before, gPlatforms.y, count * sizeof(before[0]));
+            PLATFORMS_Move(&gPlatforms, &gBounds);
+
+            for (int i = 0; i < count; i++) {
+                bool due = (move - anchor[i]) % interval[i] == 0;
+                bool moved = gPlatforms.y[i] != before[i];
+                if (due != moved) Fail("roda: plataforma %d, chamada %lu", i, move, due, moved);
+                gChecks++;
+            }
+
+            if (move == TEST_WHEEL_MOVES / 2) {
+                for (int i = 0; i < count; i += 2) {
+                    PLATFORM_CONFIG_t cfg = { .x = gPlatforms.x[i], .y = gPlatforms.y[i], .width = 4, .height = 2, .is_moving = true,
+                                              .direction = PLATFORMS_GetDirection(&gPlatforms, i),
+                                              .speed_interval = (uint8_t)(1 + RANDOM_Below(&gRandom, TEST_MAX_INTERVAL)) };
+                    PLATFORMS_Set(&gPlatforms, i, cfg);
+                    anchor[i] = move; interval[i] = cfg.speed_interval;
+                }
+            }
+        }
+    }
+}
+
+/****************************
+* MAIN
+****************************/
+static void Usage(const char* program) {
+    fprintf(stderr, "uso: %s lookahead|index|wheel\n", program);
+    fprintf(stderr, "  lookahead  PLATFORMS_YAt/NextStep contra PLATFORMS_Move, com remocoes e reinsercoes\n");
+    fprintf(stderr, "  index      baldes de colunas contra a busca linear, depois de SetX/Remove/Set/ShiftX\n");
+    fprintf(stderr, "  wheel      roda das travessias: cada passo no tick certo, dando a volta nos %d slots\n", PLATFORM_WHEEL_SLOTS);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    gRandom = RANDOM_Seed(12345);
+    if (!strcmp(argv[1], "lookahead")) TestLookahead();
+    else if (!strcmp(argv[1], "index")) TestIndex();
+    else if (!strcmp(argv[1], "wheel")) TestWheel();
+    else {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    printf("%s: %lu verificacoes, %lu falhas\n", argv[1], gChecks, gErrors);
+    return gErrors ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <include/replay.h>
+#include <include/random.h>
+
+/****************************
+* DEFINES
+****************************/
+#define TEST_SAMPLES_MAX 4096
+#define TEST_CAPACITY ( REPLAY_HEADER_SIZE + 40 ) // Pequeno para encher de verdade
+#define TEST_MAX_ERRORS 20                        // Depois disso só conta
+
+/****************************
+* VARIABLES
+****************************/
+static uint8_t gSamples[TEST_SAMPLES_MAX];   // Amostras aceitas por REPLAY_Record, na ordem
+static uint32_t gRandom;
+static unsigned long gErrors;
+static unsigned long gChecks;
+
+/****************************
+* AUXILIARES
+****************************/
+static void Fail(const char* name, const char* what, long expected, long actual) {
+    if (gErrors++ < TEST_MAX_ERRORS) printf("FALHA %s: %s: esperado %ld, obtido %ld\n", name, what, expected, actual);
+}
+
+static void Check(const char* name, const char* what, long expected, long actual) {
+    gChecks++;
+    if (expected != actual) Fail(name, what, expected, actual);
+}
+
+// Lê o fluxo inteiro e compara com as amostras gravadas; ao fim, REPLAY_Next solta os botões
+static void CheckStream(const char* name, REPLAY_t* replay, int count) {
+    uint8_t buttons;
+
+    for (int n = 0; n < count; n++) {
+        Check(name, "REPLAY_Next antes do fim", 1, REPLAY_Next(replay, &buttons));
+        Check(name, "amostra", gSamples[n], buttons);
+    }
+    Check(name, "REPLAY_Next no fim", 0, REPLAY_Next(replay, &buttons));
+    Check(name, "botoes no fim", 0, buttons);
+}
+
+// Grava, copia por REPLAY_Load e confere semente, contagem e amostras nos dois lados. Toda
+// versão cortada do fluxo tem que ser recusada, e também uma com um byte a mais.
+static void RoundTrip(const char* name, REPLAY_t* recorded, int count, size_t expected_size) {
+    REPLAY_t* loaded = REPLAY_Init(recorded->capacity + 1);
+
+    Check(name, "tamanho", (long)expected_size, (long)recorded->size);
+    Check(name, "REPLAY_GetSamples", count, (long)REPLAY_GetSamples(recorded));
+    REPLAY_Rewind(recorded);
+    CheckStream(name, recorded, count);
+
+    Check(name, "REPLAY_Load", 1, REPLAY_Load(loaded, recorded->data, recorded->size));
+    Check(name, "semente", (long)recorded->seed, (long)loaded->seed);
+    Check(name, "REPLAY_GetSamples carregado", count, (long)REPLAY_GetSamples(loaded));
+    CheckStream(name, loaded, count);
+
+    for (size_t size = 0; size < recorded->size; size++) {
+        Check(name, "REPLAY_Load cortado", 0, REPLAY_Load(loaded, recorded->data, size));
+    }
+    uint8_t longer[TEST_SAMPLES_MAX + REPLAY_HEADER_SIZE + 1];
+    memcpy(longer, recorded->data, recorded->size);
+    longer[recorded->size] = recorded->data[recorded->size - 1];
+    Check(name, "REPLAY_Load com sobra", 0, REPLAY_Load(loaded, longer, recorded->size + 1));
+
+    free(loaded->data);
+    free(loaded);
+}
+
+// count amostras com os mesmos botões: corridas cheias de REPLAY_RUN_MAX e uma parcial no fim
+static void TestRun(const char* name, int count) {
+    REPLAY_t* replay = REPLAY_Init(TEST_SAMPLES_MAX);
+
+    REPLAY_Start(replay, 0xC0FFEE00u + count);
+    for (int n = 0; n < count; n++) {
+        gSamples[n] = REPLAY_BUTTON_A | REPLAY_BUTTON_B;
+        Check(name, "REPLAY_Record", 1, REPLAY_Record(replay, gSamples[n]));
+    }
+    RoundTrip(name, replay, count, REPLAY_HEADER_SIZE + (count + REPLAY_RUN_MAX - 1) / REPLAY_RUN_MAX);
+
+    free(replay->data);
+    free(replay);
+}
+
+// Entradas sorteadas até o buffer encher: a amostra recusada some, mas as que ainda cabem
+// na última corrida continuam entrando
+static void TestFull(void) {
+    REPLAY_t* replay = REPLAY_Init(TEST_CAPACITY);
+    int count = 0, refused = 0;
+    uint8_t buttons = 0;
+
+    REPLAY_Start(replay, 7);
+    for (int n = 0; n < TEST_SAMPLES_MAX && refused < 64; n++) {
+        // Em geral os botões ficam como estavam: corridas de tamanhos variados
+        if (!RANDOM_Below(&gRandom, 4)) buttons = (uint8_t)RANDOM_Below(&gRandom, 4);
+        if (REPLAY_Record(replay, buttons)) gSamples[count++] = buttons;
+        else refused++;
+    }
+    Check("cheio", "corridas ate a capacidade", TEST_CAPACITY, (long)replay->size);
+    Check("cheio", "amostras recusadas", 1, refused > 0);
+    RoundTrip("cheio", replay, count, TEST_CAPACITY);
+
+    free(replay->data);
+    free(replay);
+}
+
+/****************************
+* MAIN
+****************************/
+int main(void) {
+    gRandom = RANDOM_Seed(35);
+
+    TestRun("corrida-max", REPLAY_RUN_MAX);
+    TestRun("corrida-max+1", REPLAY_RUN_MAX + 1);
+    TestRun("corridas-multiplas", 3 * REPLAY_RUN_MAX);
+    TestFull();
+
+    printf("replay: %lu verificacoes, %lu falhas\n", gChecks, gErrors);
+    return gErrors ? 1 : 0;
+}
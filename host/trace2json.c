@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <include/trace.h>
+#include <include/game.h>
+
+/****************************
+* DEFINES
+****************************/
+#define TRACE_LINE_MAX 128
+#define TRACE_MAX_TASKS 64
+#define TRACE_NAME_MAX 32
+#define TRACE_MAX_CORES 2
+
+// Trilhas (tid) do processo único "RP2040"; os núcleos usam tid 0 e 1
+#define TID_FRAME 10
+#define TID_I2C 11
+#define TID_GAME 12
+
+/****************************
+* VARIABLES
+****************************/
+static const char* const gStateNames[] = {
+    [GAME_STATE_MENU] = "menu",
+    [GAME_STATE_PLAY] = "jogo",
+    [GAME_STATE_CONFIG] = "config",
+    [GAME_STATE_GAME_OVER] = "fim de jogo",
+    [GAME_STATE_LEVEL_COMPLETE] = "nivel completo",
+};
+
+static char gTaskNames[TRACE_MAX_TASKS][TRACE_NAME_MAX];
+
+static int gRunning[TRACE_MAX_CORES];        // Tarefa rodando em cada núcleo (-1: nenhuma vista ainda)
+static uint64_t gRunningSince[TRACE_MAX_CORES];
+static bool gFrameOpen;
+static bool gI2cOpen;
+
+static uint32_t gLastRaw;                    // Instantes da placa têm 32 bits: dão a volta a cada ~71 min
+static uint64_t gWrap;
+static uint64_t gLastTs;
+static bool gHaveTime;
+static bool gFirstEvent = true;             // Sem vírgula antes do primeiro objeto do JSON
+
+/****************************
+* SAÍDA
+****************************/
+static void Emit(const char* format, ...) {
+    va_list args;
+    printf(gFirstEvent ? "\n" : ",\n");
+    gFirstEvent = false;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static const char* TaskName(int number) {
+    if (number >= 0 && number < TRACE_MAX_TASKS && gTaskNames[number][0]) return gTaskNames[number];
+    return "?";
+}
+
+static const char* StateName(int state) {
+    if (state >= 0 && state < (int)(sizeof(gStateNames) / sizeof(gStateNames[0]))) return gStateNames[state];
+    return "?";
+}
+
+// Fecha a fatia da tarefa que rodava no núcleo até ts
+static void EndSlice(int core, uint64_t ts) {
+    if (gRunning[core] < 0) return;
+    Emit("{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%d}",
+         TaskName(gRunning[core]), (unsigned long long)gRunningSince[core],
+         (unsigned long long)(ts - gRunningSince[core]), core);
+    gRunning[core] = -1;
+}
+
+static void CloseSlices(uint64_t ts) {
+    for (int core = 0; core < TRACE_MAX_CORES; core++) EndSlice(core, ts);
+    if (gFrameOpen) Emit("{\"name\":\"quadro\",\"ph\":\"E\",\"ts\":%llu,\"pid\":1,\"tid\":%d}", (unsigned long long)ts, TID_FRAME);
+    if (gI2cOpen) Emit("{\"name\":\"i2c\",\"ph\":\"E\",\"ts\":%llu,\"pid\":1,\"tid\":%d}", (unsigned long long)ts, TID_I2C);
+    gFrameOpen = false; gI2cOpen = false;
+}
+
+static void Event(uint32_t raw, int core, int type, int arg) {
+    if (gHaveTime && raw < gLastRaw && gLastRaw - raw > 0x80000000u) gWrap += 1ull << 32;
+    gLastRaw = raw; gHaveTime = true;
+    uint64_t ts = gWrap + raw;
+    gLastTs = ts;
+    if (core < 0 || core >= TRACE_MAX_CORES) return;
+
+    switch (type) {
+        case TRACE_TASK_IN:
+            EndSlice(core, ts);
+            gRunning[core] = arg; gRunningSince[core] = ts;
+            break;
+        case TRACE_FRAME_START:
+            if (gFrameOpen) break;
+            Emit("{\"name\":\"quadro\",\"ph\":\"B\",\"ts\":%llu,\"pid\":1,\"tid\":%d}", (unsigned long long)ts, TID_FRAME);
+            gFrameOpen = true;
+            break;
+        case TRACE_FRAME_END:
+            // O anel pode começar no meio de um quadro: fim sem começo é descartado
+            if (!gFrameOpen) break;
+            Emit("{\"name\":\"quadro\",\"ph\":\"E\",\"ts\":%llu,\"pid\":1,\"tid\":%d}", (unsigned long long)ts, TID_FRAME);
+            gFrameOpen = false;
+            break;
+        case TRACE_I2C_START:
+            if (gI2cOpen) break;
+            Emit("{\"name\":\"i2c\",\"ph\":\"B\",\"ts\":%llu,\"pid\":1,\"tid\":%d,\"args\":{\"bytes\":%d,\"nucleo\":%d}}",
+                 (unsigned long long)ts, TID_I2C, arg, core);
+            gI2cOpen = true;
+            break;
+        case TRACE_I2C_END:
+            if (!gI2cOpen) break;
+            Emit("{\"name\":\"i2c\",\"ph\":\"E\",\"ts\":%llu,\"pid\":1,\"tid\":%d}", (unsigned long long)ts, TID_I2C);
+            gI2cOpen = false;
+            break;
+        case TRACE_STATE:
+            Emit("{\"name\":\"%s -> %s\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%llu,\"pid\":1,\"tid\":%d}",
+                 StateName(arg >> 8), StateName(arg & 0xFF), (unsigned long long)ts, TID_GAME);
+            break;
+        case TRACE_COLLISION:
+            Emit("{\"name\":\"pouso\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%d,\"args\":{\"plataforma\":%d}}",
+                 (unsigned long long)ts, TID_GAME, arg);
+            break;
+        default:
+            fprintf(stderr, "evento desconhecido %d\n", type);
+            break;
+    }
+}
+
+static void Metadata(void) {
+    Emit("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"RP2040\"}}");
+    for (int core = 0; core < TRACE_MAX_CORES; core++) {
+        Emit("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"nucleo %d\"}}", core, core);
+    }
+    Emit("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"quadros\"}}", TID_FRAME);
+    Emit("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"i2c\"}}", TID_I2C);
+    Emit("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"jogo\"}}", TID_GAME);
+}
+
+/****************************
+* MAIN
+****************************/
+// Lê a saída da USB (com ou sem outras linhas no meio) e escreve o JSON em stdout
+int main(int argc, char** argv) {
+    FILE* in = stdin;
+    if (argc > 2 || (argc == 2 && !(in = fopen(argv[1], "r")))) {
+        fprintf(stderr, "uso: %s [log_da_usb.txt] > trace.json\n", argv[0]);
+        return argc > 2 ? 2 : 1;
+    }
+
+    char line[TRACE_LINE_MAX];
+    unsigned long dumps = 0, events = 0, lost = 0;
+
+    for (int core = 0; core < TRACE_MAX_CORES; core++) gRunning[core] = -1;
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    Metadata();
+
+    while (fgets(line, sizeof(line), in)) {
+        unsigned long count, dropped, time_us;
+        unsigned number, core, type, arg;
+        char name[TRACE_NAME_MAX];
+
+        if (sscanf(line, "TRACE BEGIN %lu %lu", &count, &dropped) == 2) {
+            // Cada dump é um trecho separado: nada fica aberto de um para o outro
+            CloseSlices(gLastTs);
+            memset(gTaskNames, 0, sizeof(gTaskNames));
+            dumps++; lost += dropped;
+        } else if (sscanf(line, "T %u %31[^\r\n]", &number, name) == 2) {
+            if (number < TRACE_MAX_TASKS) snprintf(gTaskNames[number], TRACE_NAME_MAX, "%s", name);
+        } else if (sscanf(line, "E %lu %u %u %u", &time_us, &core, &type, &arg) == 4) {
+            Event((uint32_t)time_us, (int)core, (int)type, (int)arg);
+            events++;
+        } else if (!strncmp(line, "TRACE END", 9)) {
+            CloseSlices(gLastTs);
+        }
+    }
+    CloseSlices(gLastTs);
+    printf("\n]}\n");
+
+    if (in != stdin) fclose(in);
+    fprintf(stderr, "%lu dumps, %lu eventos (%lu sobrescritos no anel)\n", dumps, events, lost);
+
+    return dumps ? 0 : 1;
+}
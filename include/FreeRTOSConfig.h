@@ -42,7 +42,16 @@
 
 /* Scheduler Related */
 #define configUSE_PREEMPTION                    1
+/* CHAOS_POWER_SAVE = 1 (opção do CMake): tickless idle, e fora do jogo a tela apaga após um tempo sem botões.
+   O port do RP2040 só tem tickless com um núcleo. */
+#ifndef CHAOS_POWER_SAVE
+#define CHAOS_POWER_SAVE                        0
+#endif
+#if CHAOS_POWER_SAVE && !CHAOS_SMP
+#define configUSE_TICKLESS_IDLE                 1
+#else
 #define configUSE_TICKLESS_IDLE                 0
+#endif
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
 #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
@@ -70,20 +79,44 @@
 #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
 
 /* Memory allocation related definitions. */
+/* CHAOS_STATIC_ALLOC = 1 (opção do CMake): tarefas, pilhas e handles dos drivers em memória estática */
+#ifndef CHAOS_STATIC_ALLOC
+#define CHAOS_STATIC_ALLOC                      0
+#endif
+
+#if CHAOS_STATIC_ALLOC
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configTOTAL_HEAP_SIZE                   (8*1024)    /* Sobra só para o que o kernel e o SDK ainda criam sozinhos */
+#else
 #define configSUPPORT_STATIC_ALLOCATION         0
-#define configSUPPORT_DYNAMIC_ALLOCATION        1
 #define configTOTAL_HEAP_SIZE                   (128*1024)
+#endif
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
-#define configCHECK_FOR_STACK_OVERFLOW          0
-#define configUSE_MALLOC_FAILED_HOOK            0
+#define configCHECK_FOR_STACK_OVERFLOW          2   /* Confere o fim da pilha a cada troca de contexto: vApplicationStackOverflowHook em main.c */
+#define configUSE_MALLOC_FAILED_HOOK            1   /* vApplicationMallocFailedHook em main.c: estado do heap e o pedido que falhou */
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
+/* CHAOS_TASK_STATS = 1 (opção do CMake) liga as estatísticas e a tarefa TASK_Stats de main.c */
+#ifndef CHAOS_TASK_STATS
+#define CHAOS_TASK_STATS                        0
+#endif
+
+#if CHAOS_TASK_STATS
+/* Contador em microssegundos, do timer de 1 MHz do RP2040 (src/stats.c) */
+extern uint32_t STATS_RunTimeCounter( void );
+#define configGENERATE_RUN_TIME_STATS           1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        STATS_RunTimeCounter()
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+#else
 #define configGENERATE_RUN_TIME_STATS           0
-#define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+#endif
+#define configUSE_TRACE_FACILITY                1
 
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
@@ -102,13 +135,29 @@
 #define configMAX_API_CALL_INTERRUPT_PRIORITY   [dependent on processor and application]
 */
 
-// #if FREE_RTOS_KERNEL_SMP // set by the RP2040 SMP port of FreeRTOS
-// /* SMP port only */
-// #define configNUMBER_OF_CORES                   2
-// #define configTICK_CORE                         0
-// #define configRUN_MULTIPLE_PRIORITIES           1
-// #define configUSE_CORE_AFFINITY                 1
-// #endif
+/* CHAOS_SMP = 1 (opção do CMake): os dois núcleos; main.c fixa o Display no núcleo 1 e o resto no 0 */
+#ifndef CHAOS_SMP
+#define CHAOS_SMP                               0
+#endif
+
+#if CHAOS_SMP
+#define configNUMBER_OF_CORES                   2
+#define configTICK_CORE                         0
+#define configRUN_MULTIPLE_PRIORITIES           1
+#define configUSE_CORE_AFFINITY                 1
+#define configUSE_PASSIVE_IDLE_HOOK             0
+#else
+#define configNUMBER_OF_CORES                   1
+#endif
+
+/* CHAOS_AMP = 1 (opção do CMake): FreeRTOS só no núcleo 0; o núcleo 1 roda o envio do display sem RTOS (src/amp.c) */
+#ifndef CHAOS_AMP
+#define CHAOS_AMP                               0
+#endif
+
+#if CHAOS_AMP && CHAOS_SMP
+#error "CHAOS_AMP e CHAOS_SMP usam o núcleo 1 de formas diferentes: escolha um"
+#endif
 
 /* RP2040 specific */
 #define configSUPPORT_PICO_SYNC_INTEROP         1
@@ -138,5 +187,31 @@ to exclude the API function. */
 #define INCLUDE_xQueueGetMutexHolder            1
 
 /* A header file that defines trace macro can be included here. */
+/* Cada alocação do heap é somada à tarefa que a pediu; as que falham guardam o tamanho pedido (src/stats.c).
+ * Sem CHAOS_TASK_STATS o pvPortMalloc fica como o do kernel. */
+#if CHAOS_TASK_STATS
+extern void STATS_TraceMalloc( void * pvAddress, size_t uiSize );
+#define traceMALLOC( pvAddress, uiSize )        STATS_TraceMalloc( pvAddress, uiSize )
+#endif
+/* Trocas de contexto por segundo no relatório: mostra quanto o CHAOS_POWER_SAVE deixa a CPU dormir.
+ * Sem CHAOS_TASK_STATS a troca de contexto não ganha chamada nenhuma. */
+#if CHAOS_TASK_STATS
+extern void STATS_TaskSwitchedIn( void );
+#define STATS_SWITCHED_IN()                     STATS_TaskSwitchedIn()
+#else
+#define STATS_SWITCHED_IN()
+#endif
+
+/* CHAOS_TRACE = 1 (opção do CMake): trocas de contexto e eventos do jogo num anel na RAM (src/trace.c) */
+#ifndef CHAOS_TRACE
+#define CHAOS_TRACE                             0
+#endif
+
+#if CHAOS_TRACE
+extern void TRACE_TaskSwitchedIn( void * pvTCB );
+#define traceTASK_SWITCHED_IN()                 do { STATS_SWITCHED_IN(); TRACE_TaskSwitchedIn( pxCurrentTCB ); } while( 0 )
+#elif CHAOS_TASK_STATS
+#define traceTASK_SWITCHED_IN()                 STATS_SWITCHED_IN()
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
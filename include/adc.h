@@ -8,6 +8,8 @@
 #include <assert.h>
 #include <hardware/adc.h>
 
+#define ADC_MAX_HANDLES 2 // Com CHAOS_STATIC_ALLOC: eixos do joystick
+
 typedef struct
 {
     uint8_t channel;
@@ -0,0 +1,44 @@
+#ifndef _HAL_ALLOC_H
+#define _HAL_ALLOC_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+
+// Com CHAOS_STATIC_ALLOC = 1 os handles dos drivers e o framebuffer saem de vetores estáticos
+// dimensionados em tempo de compilação (*_MAX_HANDLES), e as tarefas de xTaskCreateStatic
+#ifndef CHAOS_STATIC_ALLOC
+#define CHAOS_STATIC_ALLOC 0
+#endif
+
+// Subsistemas contabilizados separadamente no relatório de memória
+typedef enum {
+    HAL_ALLOC_GPIO,
+    HAL_ALLOC_I2C,
+    HAL_ALLOC_ADC,
+    HAL_ALLOC_JOYSTICK,
+    HAL_ALLOC_D1306,
+    HAL_ALLOC_TAGS
+} HAL_ALLOC_TAG_t;
+
+typedef struct
+{
+    uint32_t bytes;
+    uint32_t count;
+}HAL_ALLOC_STATS_t;
+
+#if CHAOS_STATIC_ALLOC
+// Próximo elemento livre do vetor; handles nunca são liberados, então basta um contador
+#define HAL_ALLOC( type , pool , used , tag ) ( assert( (used) < sizeof( pool ) / sizeof( (pool)[0] ) ) , &(pool)[(used)++] )
+#else
+#define HAL_ALLOC( type , pool , used , tag ) ( (type*)HAL_Malloc( sizeof ( type ) , tag ) )
+#endif
+
+// malloc que soma bytes e chamadas por subsistema (cada driver só é iniciado por uma tarefa)
+void* HAL_Malloc( size_t , HAL_ALLOC_TAG_t );
+
+const HAL_ALLOC_STATS_t* HAL_GetAllocStats( HAL_ALLOC_TAG_t );
+
+const char* HAL_GetAllocName( HAL_ALLOC_TAG_t );
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _AMP_H
+#define _AMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver1306.h"
+
+// Quadros compartilhados entre os núcleos: um sendo composto no núcleo 0 enquanto o outro sai pelo I2C
+#define AMP_FRAMES 2
+
+// Inicia no núcleo 1 o laço sem RTOS que envia os quadros pelo display já iniciado
+void AMP_Start( D1306_t* );
+
+// Aponta o buffer do canvas para um quadro livre; false se os dois ainda estão com o núcleo 1
+bool AMP_BeginFrame( D1306_t* , uint64_t );
+
+// Entrega ao núcleo 1, pela FIFO do SIO, o quadro composto no canvas
+void AMP_SubmitFrame( D1306_t* );
+
+// Nenhum quadro em envio: o núcleo 1 está parado na FIFO e o I2C pode ser usado pelo núcleo 0
+bool AMP_IsIdle( void );
+
+// Quadros descartados porque o núcleo 1 ainda enviava os anteriores
+uint32_t AMP_GetDroppedFrames( void );
+
+#endif
@@ -4,6 +4,10 @@
 #include <pico/stdlib.h>
 #include "i2c.h"
 
+// Com CHAOS_STATIC_ALLOC: um display de até 128x64
+#define D1306_MAX_HANDLES 1
+#define D1306_MAX_BUFSIZE ( 128 * 64 / 8 )
+
 //COMMANDS 1306
 typedef enum {
     SET_CONTRAST = 0x81,
@@ -46,6 +50,9 @@ D1306_t * D1306_Init( D1306_CONFIG_t );
 
 void D1306_Invert( D1306_t * , uint8_t inv);
 
+// Liga ou apaga o painel (SET_DISP); apagado, o conteúdo da RAM do SSD1306 é mantido
+void D1306_SetPower( D1306_t * , bool );
+
 void D1306_Show( D1306_t * );
 
 void D1306_Clear( D1306_t * );
@@ -58,4 +65,6 @@ void D1306_DrawString( D1306_t* , uint32_t , uint32_t , uint32_t , const char *)
 
 void D1306_DrawSquare( D1306_t* , uint32_t , uint32_t , uint32_t , uint32_t );
 
+void D1306_BlitPage( D1306_t* , uint32_t , uint32_t , const uint8_t* , uint32_t );
+
 #endif
\ No newline at end of file
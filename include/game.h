@@ -0,0 +1,121 @@
+#ifndef _GAME_H
+#define _GAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver1306.h"
+#include "platform.h"
+#include "tilemap.h"
+
+// Com CHAOS_RTOS = 0 o jogo compila sem FreeRTOS (simulação no host)
+#ifndef CHAOS_RTOS
+#define CHAOS_RTOS 1
+#endif
+
+// Com CHAOS_GAME_LOG = 0 as mensagens de console somem (execuções em lote)
+#ifndef CHAOS_GAME_LOG
+#define CHAOS_GAME_LOG 1
+#endif
+
+// Ferramentas multithread do host definem CHAOS_GAME_TLS = _Thread_local: cada thread joga sua própria partida
+#ifndef CHAOS_GAME_TLS
+#define CHAOS_GAME_TLS
+#endif
+
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+
+#define PLAYER_WIDTH 4
+#define PLAYER_HEIGHT 4
+#define PLAYER_GRAVITY 1
+
+// Períodos das tarefas: toda a simulação avança nesses passos
+#define GAME_LOGIC_PERIOD_MS 10
+#define GAME_INPUT_PERIOD_MS 50
+#define GAME_DISPLAY_PERIOD_MS 30
+
+#define STATE_TRANSITION_DEBOUNCE_MS 200 // Botões ignorados após cada troca de tela
+
+typedef enum {
+    GAME_STATE_MENU,
+    GAME_STATE_PLAY,
+    GAME_STATE_CONFIG,
+    GAME_STATE_GAME_OVER,
+    GAME_STATE_LEVEL_COMPLETE
+} GAME_STATE_t;
+
+typedef enum {
+    GAME_MODE_LEVELS,
+    GAME_MODE_ENDLESS
+} GAME_MODE_t;
+
+// Resultado de um tick de física do personagem
+typedef enum {
+    GAME_PLAYER_FALLING,
+    GAME_PLAYER_SUPPORTED,
+    GAME_PLAYER_GOAL,       // Pousou no terreno final
+    GAME_PLAYER_DEAD        // Caiu até o fundo da tela
+} GAME_PLAYER_STEP_t;
+
+// Chamado a cada troca de estado, com a trava do jogo tomada: não pode chamar a API do jogo
+typedef void (*GAME_STATE_HOOK_t)( GAME_STATE_t , GAME_STATE_t );
+
+// Chamado, com a trava tomada, quando um nível precisa ser sorteado: quem registra chama GAME_BuildLevel depois
+typedef void (*GAME_LEVEL_HOOK_t)( void );
+
+extern CHAOS_GAME_TLS GAME_STATE_t gCurrentGameState;
+extern CHAOS_GAME_TLS GAME_MODE_t gGameMode;
+extern CHAOS_GAME_TLS int gPlayerSpeed;
+extern CHAOS_GAME_TLS int gPlayerPos[2];
+extern CHAOS_GAME_TLS int gCameraX;
+extern CHAOS_GAME_TLS int gWorldWidth;
+extern CHAOS_GAME_TLS PLATFORMS_t gPlatforms;
+extern CHAOS_GAME_TLS TILEMAP_t gTerrain;
+extern CHAOS_GAME_TLS int gGoalX;
+extern const PLATFORM_BOUNDS_t gPlatformBounds;
+
+// Fotografia de um nível do modo níveis no seu tick inicial, para jogá-lo de novo sem sortear
+typedef struct {
+    PLATFORMS_t platforms;
+    TILEMAP_t terrain;
+    int goal_x;
+    int goal_y;
+    int world_width;
+    int player_x;
+    int player_y;
+} GAME_LEVEL_t;
+
+void GAME_Init( uint32_t );
+
+void GAME_Input( bool , bool , uint64_t );
+
+// Registra quem é avisado das trocas de estado (NULL desliga); chamar antes do escalonador. GAME_Init não avisa.
+void GAME_SetStateHook( GAME_STATE_HOOK_t );
+
+// Registra quem monta os níveis fora da trava (NULL: o nível é montado na hora, sob a trava); chamar antes do escalonador
+void GAME_SetLevelHook( GAME_LEVEL_HOOK_t );
+
+// Sorteia e resolve o nível pedido sem a trava e só a toma para trocá-lo e entrar em PLAY. Sem pedido, não faz nada.
+void GAME_BuildLevel( void );
+
+void GAME_SaveLevel( GAME_LEVEL_t* );
+
+void GAME_PlayLevel( const GAME_LEVEL_t* , uint64_t );
+
+GAME_PLAYER_STEP_t GAME_StepPlayer( const PLATFORMS_t* , const TILEMAP_t* , int , int , int* , int* );
+
+int GAME_PlayerInputX( int , bool , bool );
+
+int GAME_LevelInputX( int , bool , bool , int , int );
+
+void GAME_StepPlatforms( uint64_t );
+
+void GAME_StepLogic( void );
+
+void GAME_Render( D1306_t* , uint64_t );
+
+// Se o próximo quadro pode mudar sem nenhuma entrada nova (partida, montanhas do menu, barra de "segure B").
+// Fora disso a tela só muda com um botão ou uma troca de estado.
+bool GAME_IsAnimated( void );
+
+#endif
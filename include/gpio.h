@@ -7,6 +7,8 @@
 #include <assert.h>
 #include <hardware/gpio.h>
 
+#define GPIO_MAX_HANDLES 4 // Com CHAOS_STATIC_ALLOC: botões A e B e o botão do joystick
+
 typedef struct
 {
     int pin;
@@ -21,6 +23,8 @@ typedef struct
     int logic;
 }GPIO_CONFIG_t;
 
+typedef void (*GPIO_CALLBACK_t)( void ); // Chamado em contexto de interrupção
+
 GPIO_t* GPIO_Init( GPIO_CONFIG_t );
 
 void GPIO_SetOutput( GPIO_t* , bool );
@@ -29,4 +33,7 @@ void GPIO_ToogleOutput( GPIO_t* );
 
 bool GPIO_GetInput( GPIO_t* );
 
+// Liga ou desliga a interrupção nas duas bordas do pino; o callback é um só para todos os pinos
+void GPIO_SetIrq( GPIO_t* , bool , GPIO_CALLBACK_t );
+
 #endif
\ No newline at end of file
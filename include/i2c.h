@@ -8,6 +8,8 @@
 #include <assert.h>
 #include <hardware/i2c.h>
 
+#define I2C_MAX_HANDLES 2 // Com CHAOS_STATIC_ALLOC: um por controlador
+
 typedef struct
 {
     uint8_t address;
@@ -4,6 +4,8 @@
 #include "adc.h"
 #include "gpio.h"
 
+#define JOYSTICK_MAX_HANDLES 1 // Com CHAOS_STATIC_ALLOC
+
 typedef struct
 {
     ADC_t* adc_x;
@@ -0,0 +1,124 @@
+#ifndef _PLATFORM_H
+#define _PLATFORM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PLATFORM_MAX_COUNT 256
+#define PLATFORM_FLAG_WORDS ( ( PLATFORM_MAX_COUNT + 31 ) / 32 )
+
+#define PLATFORM_NONE ( -1 )
+
+// Índice espacial: baldes de colunas com 2^PLATFORM_BUCKET_SHIFT pixels de largura.
+// O índice do balde é tomado módulo PLATFORM_BUCKET_COUNT, então o mundo pode ser mais
+// largo que a grade; apelidos só geram candidatos extras, filtrados pelo teste exato.
+#define PLATFORM_BUCKET_SHIFT 4
+#define PLATFORM_BUCKET_COUNT 64
+#define PLATFORM_BUCKET_SPAN ( PLATFORM_BUCKET_COUNT << PLATFORM_BUCKET_SHIFT )
+
+#define PLATFORM_RESET_JITTER 5     // Reaparecimento até 4 px além de reset_offset, fixo por plataforma
+#define PLATFORM_EASE_STEPS 64      // Resolução da tabela de meia volta dos caminhos suavizados
+#define PLATFORM_WHEEL_SLOTS 256    // Roda das travessias: um slot por tick, mais que o maior speed_interval
+
+typedef enum {
+    DIR_UP,
+    DIR_DOWN
+} PLATFORM_DIRECTION_t;
+
+// Armazenamento SoA: cada kernel percorre só os campos que usa.
+// O movimento é periódico e determinístico, então a altura em qualquer tick futuro sai em O(1)
+// (PLATFORMS_YAt). Dois caminhos:
+//  - travel = 0: anda 1 px a cada speed_interval ticks, sai por uma borda e volta pela outra.
+//    Fica numa roda de temporização indexada pelo tick: phase é o tick da roda do próximo passo,
+//    e PLATFORMS_Move só visita as plataformas que andam naquele tick.
+//  - travel > 0: vai e volta entre o y inicial e y +/- travel, suavizado por uma tabela de
+//    cosseno; a volta completa leva 2 * travel * speed_interval ticks e phase é a posição nela.
+typedef struct
+{
+    int16_t x[PLATFORM_MAX_COUNT];
+    int16_t y[PLATFORM_MAX_COUNT];
+    uint8_t width[PLATFORM_MAX_COUNT];
+    uint8_t height[PLATFORM_MAX_COUNT];
+    uint8_t speed_interval[PLATFORM_MAX_COUNT];
+    uint8_t travel[PLATFORM_MAX_COUNT];
+    uint8_t jitter[PLATFORM_MAX_COUNT];     // Deslocamento extra do reaparecimento (< PLATFORM_RESET_JITTER)
+    uint16_t phase[PLATFORM_MAX_COUNT];
+    uint32_t moving[PLATFORM_FLAG_WORDS];   // bit i = plataforma i é móvel
+    uint32_t down[PLATFORM_FLAG_WORDS];     // bit i = plataforma i desce (DIR_DOWN)
+    uint32_t eased[PLATFORM_FLAG_WORDS];    // bit i = plataforma i é móvel e suavizada (anda todo tick)
+    int16_t wheel[PLATFORM_WHEEL_SLOTS];    // primeira travessia que anda em cada tick da roda
+    int16_t wheel_next[PLATFORM_MAX_COUNT]; // próxima travessia do mesmo slot
+    uint8_t wheel_tick;                     // chamadas de PLATFORMS_Move, módulo PLATFORM_WHEEL_SLOTS
+    uint32_t buckets[PLATFORM_BUCKET_COUNT][PLATFORM_FLAG_WORDS]; // plataformas que cobrem cada coluna
+    uint32_t random;    // Sorteio do jitter de cada plataforma (semeado pelo jogo)
+    uint16_t count;
+}PLATFORMS_t;
+
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    uint8_t width;
+    uint8_t height;
+    bool is_moving;
+    PLATFORM_DIRECTION_t direction;
+    uint8_t speed_interval;
+    uint8_t travel;     // 0: atravessa a tela; > 0: vai e volta suavizado por tantos pixels
+}PLATFORM_CONFIG_t;
+
+typedef struct
+{
+    int16_t top;            // limite superior (plataformas que sobem somem acima dele)
+    int16_t bottom;         // limite inferior (plataformas que descem somem abaixo dele)
+    int16_t reset_offset;   // distância fora da tela onde a plataforma reaparece
+}PLATFORM_BOUNDS_t;
+
+void PLATFORMS_Clear( PLATFORMS_t* );
+
+int PLATFORMS_Add( PLATFORMS_t* , PLATFORM_CONFIG_t );
+
+void PLATFORMS_Set( PLATFORMS_t* , int , PLATFORM_CONFIG_t );
+
+void PLATFORMS_Remove( PLATFORMS_t* , int );
+
+void PLATFORMS_ShiftX( PLATFORMS_t* , int16_t );
+
+void PLATFORMS_SetX( PLATFORMS_t* , int , int16_t );
+
+void PLATFORMS_Move( PLATFORMS_t* , const PLATFORM_BOUNDS_t* );
+
+int16_t PLATFORMS_YAt( const PLATFORMS_t* , const PLATFORM_BOUNDS_t* , int , uint32_t );
+
+int PLATFORMS_NextStep( const PLATFORMS_t* , int );
+
+void PLATFORMS_QuerySpan( const PLATFORMS_t* , int16_t , int16_t , uint32_t* );
+
+int PLATFORMS_FindSupport( const PLATFORMS_t* , int16_t , int16_t , int16_t , int16_t , int16_t );
+
+static inline bool PLATFORMS_IsMoving( const PLATFORMS_t* platforms , int i )
+{
+    return ( platforms->moving[i >> 5] >> ( i & 31 ) ) & 1;
+}
+
+static inline PLATFORM_DIRECTION_t PLATFORMS_GetDirection( const PLATFORMS_t* platforms , int i )
+{
+    return ( ( platforms->down[i >> 5] >> ( i & 31 ) ) & 1 ) ? DIR_DOWN : DIR_UP;
+}
+
+// Retira e devolve o menor índice marcado na máscara, ou PLATFORM_NONE se ela estiver vazia
+static inline int PLATFORMS_PopMask( uint32_t* mask )
+{
+    for( int word = 0 ; word < PLATFORM_FLAG_WORDS ; ++word )
+    {
+        if( mask[word] )
+        {
+            int i = ( word << 5 ) + __builtin_ctz( mask[word] );
+            mask[word] &= mask[word] - 1;
+            return i;
+        }
+    }
+    return PLATFORM_NONE;
+}
+
+#endif
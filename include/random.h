@@ -0,0 +1,27 @@
+#ifndef _RANDOM_H
+#define _RANDOM_H
+
+#include <stdint.h>
+
+// xorshift32: sequência reprodutível a partir de uma semente, sem o estado global de rand()
+static inline uint32_t RANDOM_Seed( uint32_t seed )
+{
+    return seed ? seed : 0x9E3779B9u; // Zero é ponto fixo do xorshift
+}
+
+static inline uint32_t RANDOM_Next( uint32_t* state )
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Inteiro em [0, n)
+static inline int RANDOM_Below( uint32_t* state , int n )
+{
+    return (int)( RANDOM_Next( state ) % (uint32_t)n );
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _REPLAY_H
+#define _REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Fluxo gravado: cabeçalho com a semente dos níveis e o número de corridas, seguido das
+// corridas de um byte.
+// Cada corrida cobre até REPLAY_RUN_MAX amostras seguidas de GAME_Input (uma por
+// GAME_INPUT_PERIOD_MS) com o mesmo estado dos botões: bits 7..6 = botões, 5..0 = amostras - 1.
+#define REPLAY_BUTTON_A 0x1
+#define REPLAY_BUTTON_B 0x2
+
+#define REPLAY_MAGIC_0 'C'
+#define REPLAY_MAGIC_1 'R'
+#define REPLAY_VERSION 2
+#define REPLAY_HEADER_SIZE 11 // magia (2), versão (1), semente (4), corridas (4), little-endian
+
+#define REPLAY_RUN_MAX 64
+
+typedef struct
+{
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    uint32_t seed;
+    size_t cursor;          // Leitura: próxima corrida
+    uint8_t remaining;      // Leitura: amostras que faltam na corrida atual
+    uint8_t buttons;        // Leitura: botões da corrida atual
+}REPLAY_t;
+
+REPLAY_t* REPLAY_Init( size_t );
+
+void REPLAY_Start( REPLAY_t* , uint32_t );
+
+bool REPLAY_Record( REPLAY_t* , uint8_t );
+
+bool REPLAY_Load( REPLAY_t* , const uint8_t* , size_t );
+
+void REPLAY_Rewind( REPLAY_t* );
+
+bool REPLAY_Next( REPLAY_t* , uint8_t* );
+
+uint32_t REPLAY_GetSamples( const REPLAY_t* );
+
+#endif
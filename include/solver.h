@@ -0,0 +1,41 @@
+#ifndef _SOLVER_H
+#define _SOLVER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "game.h"
+
+// Busca em largura sobre (x, y) do personagem, tick a tick, contra as trajetórias determinísticas
+// das plataformas. Estados repetidos no mesmo tick são fundidos por um bitset.
+// Só esperar e andar para a direita (inclusive no ar) são explorados: é o que resolve quase todos
+// os níveis, com uma fração dos estados. A resposta é conservadora: solúvel aqui, solúvel no jogo.
+// Sobre a mesma plataforma fica só o estado mais à direita, que domina os outros sem mudar a resposta.
+// Com limite de estados por tick a busca vira um feixe: ficam os apoiados e, entre eles, os mais à direita.
+#define SOLVER_MAX_WIDTH 512        // Largura máxima do nível em pixels
+#define SOLVER_Y_MIN ( -16 )        // Personagem carregado acima da tela por uma plataforma
+#define SOLVER_Y_MAX ( SCREEN_HEIGHT + 16 ) // Apoiado, ele também desce abaixo da tela com ela
+#define SOLVER_MAX_STATES 1024      // Estados vivos por tick (busca completa, ferramentas de host)
+#define SOLVER_MAX_TICKS 1500       // Horizonte padrão: 15 s de jogo
+#define SOLVER_MAX_EXPANDED 150000  // Orçamento da busca completa
+
+// Sorteio dos níveis no jogo: feixe estreito, ~10 ms por tentativa na placa (estimativa de ~2,5 us
+// por estado; confira com o caso "SOLVER_Run (tentativa)" do chaos-bench). Só serve para aceitar:
+// o feixe perde caminhos (o chaos-difficulty mede quantos), então um não dele vai para a busca completa.
+#define SOLVER_LEVEL_STATES 4
+#define SOLVER_LEVEL_EXPANDED 4000
+
+typedef struct
+{
+    bool solvable;
+    uint32_t ticks;         // Ticks de lógica até o nível completo (o mais rápido possível)
+    uint32_t expanded;      // Estados expandidos
+    uint32_t peak_states;   // Maior número de estados vivos em um tick
+    bool truncated;         // Algum tick excedeu o limite de estados (ticks pode não ser o mínimo)
+    bool exhausted;         // Parou por orçamento, sem resposta definitiva
+}SOLVER_RESULT_t;
+
+// Nível, velocidade do personagem, horizonte em ticks, orçamento de estados expandidos e
+// limite de estados vivos por tick (até SOLVER_MAX_STATES). Só lê o nível: roda fora da trava do jogo.
+SOLVER_RESULT_t SOLVER_Run( const GAME_LEVEL_t* , int , uint32_t , uint32_t , uint16_t );
+
+#endif
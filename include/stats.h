@@ -0,0 +1,42 @@
+#ifndef _STATS_H
+#define _STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define STATS_MAX_TASKS 16
+
+// Pilha sugerida: o máximo já usado mais 25% de folga, arredondado para STATS_STACK_ROUND palavras
+#define STATS_STACK_ROUND 16
+
+// Contador das estatísticas de execução do FreeRTOS (portGET_RUN_TIME_COUNTER_VALUE): timer de 1 MHz
+uint32_t STATS_RunTimeCounter( void );
+
+// Registra o tamanho (em palavras, como em xTaskCreate) da pilha de uma tarefa, para o relatório
+void STATS_Watch( TaskHandle_t , uint32_t );
+
+// Imprime, por tarefa, a CPU usada desde a chamada anterior, o estado e o uso de pilha
+void STATS_Print( void );
+
+// Mudança nos botões vista pela tarefa de entrada (now_us: instante da amostra)
+void STATS_InputEdge( uint32_t );
+
+// Quadro enviado: composição começou em start_us e o envio terminou em end_us.
+// A latência botão → tela vai da amostra até o fim do primeiro quadro composto depois dela.
+void STATS_FrameSent( uint32_t , uint32_t );
+
+// traceTASK_SWITCHED_IN: conta as trocas de contexto, mostradas por segundo em STATS_Print
+void STATS_TaskSwitchedIn( void );
+
+// traceMALLOC: soma cada alocação do heap do FreeRTOS à tarefa que a pediu ("boot" antes do escalonador)
+void STATS_TraceMalloc( void* , size_t );
+
+// Tamanho do último pvPortMalloc que falhou (0 se nenhum)
+size_t STATS_GetFailedMalloc( void );
+
+// Uso, pico e fragmentação do heap do FreeRTOS, alocações por tarefa e malloc dos drivers
+void STATS_PrintHeap( void );
+
+#endif
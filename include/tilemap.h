@@ -0,0 +1,40 @@
+#ifndef _TILEMAP_H
+#define _TILEMAP_H
+
+#include "driver1306.h"
+
+#define TILE_SIZE 8
+#define TILEMAP_ROWS 8          // Uma linha de tiles por página do SSD1306
+#define TILEMAP_COLUMNS 128     // Anel de colunas: 1024 px de mundo
+#define TILEMAP_SPAN ( TILEMAP_COLUMNS * TILE_SIZE )
+
+#define TILE_GROUND_BAND 4      // Altura da faixa sólida no topo do terreno
+
+typedef enum {
+    TILE_EMPTY = 0,
+    TILE_GROUND_TOP = 1,        // + deslocamento da faixa dentro da página (0..7)
+    TILE_GROUND_SPILL = 9,      // + (deslocamento - 5): resto da faixa na página seguinte
+    TILE_GROUND_FILL = 12,      // + paridade das linhas pontilhadas
+    TILE_COUNT = 14
+}TILE_t;
+
+typedef struct
+{
+    uint8_t tiles[TILEMAP_COLUMNS][TILEMAP_ROWS];
+    uint8_t solid[TILEMAP_COLUMNS];     // bit r = tile (coluna, r) tem colisão
+    uint8_t occupied[TILEMAP_COLUMNS];  // bit r = tile (coluna, r) não é vazio
+}TILEMAP_t;
+
+void TILEMAP_Clear( TILEMAP_t* );
+
+void TILEMAP_ClearColumns( TILEMAP_t* , int , int );
+
+void TILEMAP_SetTile( TILEMAP_t* , int , int , uint8_t );
+
+void TILEMAP_FillGround( TILEMAP_t* , int , int , int );
+
+bool TILEMAP_IsSolid( const TILEMAP_t* , int , int );
+
+void TILEMAP_Render( const TILEMAP_t* , D1306_t* , int );
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Com CHAOS_TRACE = 1 cada evento vai, com o instante em us, para um anel na RAM;
+// TRACE_Dump o imprime como texto, e host/trace2json.c converte para o formato do Chrome/Perfetto
+#define TRACE_CAPACITY 2048 // Eventos (8 bytes cada); potência de 2
+
+typedef enum {
+    TRACE_TASK_IN,      // arg: número da tarefa (uxTaskGetTaskNumber) que passou a rodar no núcleo
+    TRACE_FRAME_START,  // Display começou a compor um quadro
+    TRACE_FRAME_END,    // Quadro enviado (com AMP: entregue ao núcleo 1)
+    TRACE_I2C_START,    // arg: bytes da transferência
+    TRACE_I2C_END,
+    TRACE_STATE,        // arg: estado anterior << 8 | novo estado
+    TRACE_COLLISION,    // arg: plataforma em que o personagem pousou
+    TRACE_TYPES
+} TRACE_TYPE_t;
+
+typedef struct
+{
+    uint32_t time_us;
+    uint8_t type;
+    uint8_t core;
+    uint16_t arg;
+}TRACE_EVENT_t;
+
+// Reserva a trava entre núcleos; antes disso os eventos são ignorados
+void TRACE_Init( void );
+
+// Pode ser chamada de tarefas, interrupções e dos dois núcleos
+void TRACE_Record( TRACE_TYPE_t , uint16_t );
+
+// Dá à tarefa o número (vTaskSetTaskNumber) gravado nas trocas de contexto e impresso no dump.
+// O kernel começa todas em 0: chamar para cada tarefa criada.
+void TRACE_NumberTask( void* );
+
+// Numera as tarefas que ainda estão em 0: os idle e o daemon de timers, criados pelo escalonador
+void TRACE_NumberTasks( void );
+
+// traceTASK_SWITCHED_IN: recebe o TCB que passou a rodar
+void TRACE_TaskSwitchedIn( void* );
+
+// Imprime a tabela de tarefas e os eventos do mais antigo ao mais novo, e esvazia o anel.
+// A gravação fica parada durante a impressão, que não aparece no trace.
+void TRACE_Dump( void );
+
+#endif
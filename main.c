@@ -8,434 +8,430 @@
 #include <include/driver1306.h>
 #include <include/gpio.h>
 #include <include/joystick.h>
+#include <include/game.h>
+#include <include/alloc.h>
+#if CHAOS_TASK_STATS
+#include <include/stats.h>
+#endif
+#if CHAOS_AMP
+#include <include/amp.h>
+#endif
+#if CHAOS_TRACE
+#include <include/trace.h>
+#endif
 
 /****************************
 * DEFINES
 ****************************/
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
-
-#define PLAYER_WIDTH 4
-#define PLAYER_HEIGHT 4
-#define PLAYER_GRAVITY 1
-
-#define PLAYER_SPEED_DEFAULT PLAYER_WIDTH
-#define PLAYER_SPEED_MIN 1
-#define PLAYER_SPEED_MAX 8
-
-#define MOBILE_PLATFORM_WIDTH 20
-#define MOBILE_PLATFORM_HEIGHT 2 // Espessura das plataformas móveis
-
-#define STATIC_PLATFORM_DEFAULT_WIDTH 25
-#define STATIC_PLATFORM_HEIGHT 4 // Altura das plataformas fixas
-
-#define NUM_PLATFORMS 10
-#define NUM_MOVING_PLATFORMS 8
-
-#define MIN_MOVING_PLATFORM_INTERVAL 1 // Plataforma mais rápida
-#define MAX_MOVING_PLATFORM_INTERVAL 5 // Plataforma mais lenta
-
 #define BUTTON_A_PIN 5
 #define BUTTON_B_PIN 6
-
-#define HORIZONTAL_SPACING 1
-
-#define TOP_SCREEN_BOUNDARY 0
-#define BOTTOM_SCREEN_BOUNDARY (SCREEN_HEIGHT - MOBILE_PLATFORM_HEIGHT)
-
-#define PLATFORM_RESET_OFFSET 10
-
-#define MIN_STATIC_PLATFORM_Y (SCREEN_HEIGHT - 40)
-#define MAX_STATIC_PLATFORM_Y (SCREEN_HEIGHT - STATIC_PLATFORM_HEIGHT)
-
-#define INITIAL_PAIR_BOTTOM_Y (SCREEN_HEIGHT - MOBILE_PLATFORM_HEIGHT - 5)
-#define INITIAL_PAIR_TOP_Y_OFFSET (SCREEN_HEIGHT / 2 - MOBILE_PLATFORM_HEIGHT / 2)
-
-#define VERTICAL_COLUMN_CONSTANT_GAP (INITIAL_PAIR_BOTTOM_Y - INITIAL_PAIR_TOP_Y_OFFSET)
-
-#define LONG_PRESS_TIME_MS 1000
-#define STATE_TRANSITION_DEBOUNCE_MS 200
-#define SHORT_CLICK_MAX_TIME_MS 200
-
-/****************************
-* TYPEDEF
-****************************/
-
-typedef enum {
-    GAME_STATE_MENU,
-    GAME_STATE_PLAY,
-    GAME_STATE_CONFIG,
-    GAME_STATE_GAME_OVER,
-    GAME_STATE_LEVEL_COMPLETE
-} GAME_STATE_t;
-
-typedef enum {
-    DIR_UP,
-    DIR_DOWN
-} PLATFORM_DIRECTION_t;
-
-typedef struct {
-    int x;
-    int y;
-    int width;
-    int height;
-    bool is_moving;
-    PLATFORM_DIRECTION_t direction;
-    int speed_interval;
-    int move_counter;
-} PLATFORM_t;
+#define STATS_PERIOD_MS 2000
+#define TRACE_POLL_MS 100 // Com CHAOS_TRACE: de quanto em quanto tempo a USB é olhada à espera do 't'
+
+// Com CHAOS_POWER_SAVE: fora do jogo, tempo sem mexer nos botões até apagar a tela
+#define POWER_IDLE_TIMEOUT_MS 30000
+
+// Com CHAOS_SMP: composição e envio do quadro no núcleo 1, simulação e entrada no núcleo 0
+#define CORE_SIMULATION (1 << 0)
+#define CORE_DISPLAY (1 << 1)
+
+// Pilhas em palavras; a tarefa Stats sugere novos valores pelo uso medido
+#define STACK_DISPLAY 256
+#define STACK_BUTTON_CONTROL 256
+#define STACK_PLATFORM_MOVEMENT 256
+#define STACK_GAME_LOGIC 256
+#define STACK_LEVEL 256
+#define STACK_STATS 512
+#define STACK_TRACE 512
+
+// Stats e Trace só existem com as opções ligadas (CHAOS_TASK_STATS e CHAOS_TRACE valem 0 ou 1)
+#define TASK_COUNT (5 + CHAOS_TASK_STATS + CHAOS_TRACE)
+#define STACK_TOTAL (STACK_DISPLAY + STACK_BUTTON_CONTROL + STACK_PLATFORM_MOVEMENT + STACK_GAME_LOGIC + STACK_LEVEL + \
+                     CHAOS_TASK_STATS * STACK_STATS + CHAOS_TRACE * STACK_TRACE)
 
 /****************************
 * VARIABLES
 ****************************/
 D1306_t * gDisplay;
+static const D1306_CONFIG_t gDisplayConfig = {
+    .external_vcc = false, .width = SCREEN_WIDTH, .height = SCREEN_HEIGHT,
+    .i2c_cfg.address = 0x3C, .i2c_cfg.frequency = 400 * 1000,
+    .i2c_cfg.i2c_id = 1, .i2c_cfg.pin_sda = 14, .i2c_cfg.pin_sdl = 15
+};
 bool gStateButtonA;
 bool gStateButtonB;
 
-GAME_STATE_t gCurrentGameState = GAME_STATE_MENU;
-
-int gPlayerSpeed = PLAYER_SPEED_DEFAULT;
-
-static uint64_t b_press_start_time_us = 0;
-static bool b_long_pressed_triggered = false;
+static TaskHandle_t gTaskDisplay;
+static TaskHandle_t gTaskButtonControl;
+static TaskHandle_t gTaskPlatformMovement;
+static TaskHandle_t gTaskGameLogic;
+static TaskHandle_t gTaskLevel;
+
+#if CHAOS_POWER_SAVE
+// Tela apagada: Display fica bloqueado até ButtonControl notificar que um botão acordou tudo
+static volatile bool gAsleep;
+#endif
+
+#if CHAOS_STATIC_ALLOC
+// Pilhas e TCBs no .bss: o uso de RAM das tarefas aparece no mapa do link
+static StackType_t gTaskStacks[STACK_TOTAL];
+static size_t gTaskStacksUsed;
+static StaticTask_t gTaskBuffers[TASK_COUNT];
+static size_t gTaskBuffersUsed;
+
+static StackType_t gIdleStack[configMINIMAL_STACK_SIZE];
+static StaticTask_t gIdleBuffer;
+static StackType_t gTimerStack[configTIMER_TASK_STACK_DEPTH];
+static StaticTask_t gTimerBuffer;
+#if configNUMBER_OF_CORES > 1
+static StackType_t gPassiveIdleStacks[configNUMBER_OF_CORES - 1][configMINIMAL_STACK_SIZE];
+static StaticTask_t gPassiveIdleBuffers[configNUMBER_OF_CORES - 1];
+#endif
+#endif
 
-static int gLastLevelFinalPlatformY = -1; // -1: Primeira partida
+/****************************
+* CICLO DE VIDA
+****************************/
+// PlatformMovement e GameLogic só trabalham em PLAY: fora dele ficam bloqueadas, sem acordar a cada tick.
+// Notificações que sobraram de outra entrada em PLAY só refazem o teste.
+static void WaitForPlay() {
+    while (gCurrentGameState != GAME_STATE_PLAY) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
 
-int gPlayerPos[2];
-PLATFORM_t gPlatforms[NUM_PLATFORMS];
+// Gancho das trocas de estado (trava do jogo tomada): entrar em PLAY acorda as tarefas da partida.
+// Na saída elas param no próximo WaitForPlay, no máximo um tick depois.
+static void GameStateChanged(GAME_STATE_t from, GAME_STATE_t to) {
+#if CHAOS_TRACE
+    TRACE_Record(TRACE_STATE, (uint16_t)(from << 8 | to));
+#else
+    (void)from;
+#endif
+    if (to == GAME_STATE_PLAY) {
+        xTaskNotifyGive(gTaskPlatformMovement);
+        xTaskNotifyGive(gTaskGameLogic);
+    }
+#if CHAOS_POWER_SAVE
+    xTaskNotifyGive(gTaskDisplay); // Tela nova: Display pode estar parado na anterior
+    xTaskNotifyGive(gTaskButtonControl); // Recomeça a contagem para apagar a tela
+#endif
+}
 
+// Gancho dos pedidos de nível (trava do jogo tomada): o sorteio fica para a tarefa Level
+static void LevelRequested() {
+    xTaskNotifyGive(gTaskLevel);
+}
 
 /****************************
-* FUNÇÕES DE INICIALIZAÇÃO DO JOGO
+* ENERGIA
 ****************************/
+#if CHAOS_POWER_SAVE
+// Display: apaga o painel, espera o despertar e o liga de novo (a RAM do SSD1306 guarda o último quadro)
+static void PowerDisplaySleep() {
+#if CHAOS_AMP
+    // O I2C é do núcleo 1 enquanto houver quadro em envio
+    while (!AMP_IsIdle()) vTaskDelay(1);
+#endif
+    D1306_SetPower(gDisplay, false);
+    while (gAsleep) ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Notificação de outro despertar só refaz o teste
+    D1306_SetPower(gDisplay, true);
+}
 
-void InitGameElements() {
-    int num_unique_moving_columns = 4;
-    int total_moving_columns_width = num_unique_moving_columns * MOBILE_PLATFORM_WIDTH;
-    int total_spacing_width = (num_unique_moving_columns + 1) * HORIZONTAL_SPACING;
-
-    int remaining_width = SCREEN_WIDTH - total_moving_columns_width - total_spacing_width;
-    int static_platform_width = remaining_width / 2;
-
-    // Plataforma inicial (gPlatforms[0])
-    gPlatforms[0] = (PLATFORM_t){
-        .x = 0,
-        .y = (gLastLevelFinalPlatformY != -1) ? gLastLevelFinalPlatformY :
-             (rand() % (MAX_STATIC_PLATFORM_Y - MIN_STATIC_PLATFORM_Y + 1)) + MIN_STATIC_PLATFORM_Y,
-        .width = static_platform_width,
-        .height = STATIC_PLATFORM_HEIGHT,
-        .is_moving = false
-    };
-
-    // Colunas de plataformas móveis (gPlatforms[1] a gPlatforms[8])
-    // Coluna 1 (gPlatforms[1] e gPlatforms[2])
-    gPlatforms[1] = (PLATFORM_t){
-        .x = gPlatforms[0].x + gPlatforms[0].width + HORIZONTAL_SPACING,
-        .y = INITIAL_PAIR_BOTTOM_Y,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = (rand() % 2 == 0) ? DIR_UP : DIR_DOWN,
-        .speed_interval = (rand() % (MAX_MOVING_PLATFORM_INTERVAL - MIN_MOVING_PLATFORM_INTERVAL + 1)) + MIN_MOVING_PLATFORM_INTERVAL,
-        .move_counter = 0
-    };
-    gPlatforms[2] = (PLATFORM_t){
-        .x = gPlatforms[1].x, .y = INITIAL_PAIR_TOP_Y_OFFSET,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = gPlatforms[1].direction, .speed_interval = gPlatforms[1].speed_interval, .move_counter = 0
-    };
-
-    // Coluna 2 (gPlatforms[3] e gPlatforms[4])
-    gPlatforms[3] = (PLATFORM_t){
-        .x = gPlatforms[1].x + MOBILE_PLATFORM_WIDTH + HORIZONTAL_SPACING,
-        .y = INITIAL_PAIR_BOTTOM_Y,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = (rand() % 2 == 0) ? DIR_UP : DIR_DOWN,
-        .speed_interval = (rand() % (MAX_MOVING_PLATFORM_INTERVAL - MIN_MOVING_PLATFORM_INTERVAL + 1)) + MIN_MOVING_PLATFORM_INTERVAL,
-        .move_counter = 0
-    };
-    gPlatforms[4] = (PLATFORM_t){
-        .x = gPlatforms[3].x, .y = INITIAL_PAIR_TOP_Y_OFFSET,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = gPlatforms[3].direction, .speed_interval = gPlatforms[3].speed_interval, .move_counter = 0
-    };
-
-    // Coluna 3 (gPlatforms[5] e gPlatforms[6])
-    gPlatforms[5] = (PLATFORM_t){
-        .x = gPlatforms[3].x + MOBILE_PLATFORM_WIDTH + HORIZONTAL_SPACING,
-        .y = INITIAL_PAIR_BOTTOM_Y,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = (rand() % 2 == 0) ? DIR_UP : DIR_DOWN,
-        .speed_interval = (rand() % (MAX_MOVING_PLATFORM_INTERVAL - MIN_MOVING_PLATFORM_INTERVAL + 1)) + MIN_MOVING_PLATFORM_INTERVAL,
-        .move_counter = 0
-    };
-    gPlatforms[6] = (PLATFORM_t){
-        .x = gPlatforms[5].x, .y = INITIAL_PAIR_TOP_Y_OFFSET,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = gPlatforms[5].direction, .speed_interval = gPlatforms[5].speed_interval, .move_counter = 0
-    };
-
-    // Coluna 4 (gPlatforms[7] e gPlatforms[8])
-    gPlatforms[7] = (PLATFORM_t){
-        .x = gPlatforms[5].x + MOBILE_PLATFORM_WIDTH + HORIZONTAL_SPACING,
-        .y = INITIAL_PAIR_BOTTOM_Y,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = (rand() % 2 == 0) ? DIR_UP : DIR_DOWN,
-        .speed_interval = (rand() % (MAX_MOVING_PLATFORM_INTERVAL - MIN_MOVING_PLATFORM_INTERVAL + 1)) + MIN_MOVING_PLATFORM_INTERVAL,
-        .move_counter = 0
-    };
-    gPlatforms[8] = (PLATFORM_t){
-        .x = gPlatforms[7].x, .y = INITIAL_PAIR_TOP_Y_OFFSET,
-        .width = MOBILE_PLATFORM_WIDTH, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
-        .direction = gPlatforms[7].direction, .speed_interval = gPlatforms[7].speed_interval, .move_counter = 0
-    };
-
-    // Plataforma final (gPlatforms[9])
-    gPlatforms[9] = (PLATFORM_t){
-        .x = gPlatforms[7].x + MOBILE_PLATFORM_WIDTH + HORIZONTAL_SPACING,
-        .y = (rand() % (MAX_STATIC_PLATFORM_Y - MIN_STATIC_PLATFORM_Y + 1)) + MIN_STATIC_PLATFORM_Y,
-        .width = static_platform_width, .height = STATIC_PLATFORM_HEIGHT, .is_moving = false
-    };
-
-    if (gPlatforms[9].x + gPlatforms[9].width < SCREEN_WIDTH) {
-        gPlatforms[9].width = SCREEN_WIDTH - gPlatforms[9].x;
-    }
+// Interrupção de borda dos botões: acorda ButtonControl
+static void PowerButtonIrq() {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(gTaskButtonControl, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// ButtonControl: quanto esperar por uma borda antes de apagar a tela. Em PLAY a tela não apaga,
+// e a saída dele chega como notificação do gancho de estado.
+static TickType_t PowerIdleWait(uint64_t last_activity_us) {
+    if (gCurrentGameState == GAME_STATE_PLAY) return portMAX_DELAY;
+    uint64_t idle_ms = (time_us_64() - last_activity_us) / 1000;
+    return idle_ms >= POWER_IDLE_TIMEOUT_MS ? 0 : pdMS_TO_TICKS(POWER_IDLE_TIMEOUT_MS - idle_ms);
+}
+
+// ButtonControl: sem ninguém acordado para pedir o tick, o idle dorme até a interrupção de um botão
+static void PowerSleep(GPIO_t* button_a, GPIO_t* button_b) {
+    gAsleep = true;
+    xTaskNotifyGive(gTaskDisplay); // Display pode estar parado numa tela estática
+    ulTaskNotifyTake(pdTRUE, 0);
+    // Botão apertado entre a última amostra e agora: não dorme
+    if (GPIO_GetInput(button_a) && GPIO_GetInput(button_b)) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
-    // Posição inicial do personagem na primeira plataforma fixa
-    gPlayerPos[0] = gPlatforms[0].x + (gPlatforms[0].width / 2) - (PLAYER_WIDTH / 2);
-    gPlayerPos[1] = gPlatforms[0].y - PLAYER_HEIGHT;
+    gAsleep = false;
+    xTaskNotifyGive(gTaskDisplay); // PlatformMovement e GameLogic já esperam por PLAY
+
+    // O aperto que acordou não vira entrada do jogo
+    while (!GPIO_GetInput(button_a) || !GPIO_GetInput(button_b)) vTaskDelay(pdMS_TO_TICKS(GAME_INPUT_PERIOD_MS));
 }
+#endif
 
 /****************************
 * TASKS
 ****************************/
 
+// Display: com CHAOS_POWER_SAVE, tela parada só é redesenhada quando um botão ou uma troca de estado
+// avisa. Sem quadro composto (AMP sem quadro livre) tenta de novo no próximo período.
+static void DisplayWait(bool drawn) {
+#if CHAOS_POWER_SAVE
+    if (drawn && !GAME_IsAnimated()) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        return;
+    }
+#else
+    (void)drawn;
+#endif
+    vTaskDelay(pdMS_TO_TICKS(GAME_DISPLAY_PERIOD_MS));
+}
+
+#if CHAOS_AMP
+// Só compõe: o display foi iniciado em main e o núcleo 1 faz o envio. Sem quadro livre, pula este.
 void TASK_Display() {
-    D1306_CONFIG_t cfg = {
-        .external_vcc = false, .width = SCREEN_WIDTH, .height = SCREEN_HEIGHT,
-        .i2c_cfg.address = 0x3C, .i2c_cfg.frequency = 400 * 1000,
-        .i2c_cfg.i2c_id = 1, .i2c_cfg.pin_sda = 14, .i2c_cfg.pin_sdl = 15
-    };
-    gDisplay = D1306_Init(cfg);
-    char str_buffer[20];
+    D1306_t canvas = *gDisplay;
 
     while (true) {
-        D1306_Clear(gDisplay);
-
-        if (gCurrentGameState == GAME_STATE_MENU) {
-            int mountain_base_y = 40; int peak_height = 20;
-            for (int x = 0; x < SCREEN_WIDTH / 2; x += 3) {
-                int y_offset = rand() % (peak_height / 2) - (peak_height / 4);
-                int current_height = (int)((float)peak_height * (1.0f - (float)x / (SCREEN_WIDTH / 2))) + y_offset;
-                if (current_height < 1) current_height = 1;
-                D1306_DrawSquare(gDisplay, x, mountain_base_y - current_height, 2, current_height);
-                if (rand() % 10 < 3) D1306_DrawPixel(gDisplay, x + rand()%2, mountain_base_y - current_height - (rand()%5 + 1));
-            }
-            for (int x = SCREEN_WIDTH / 2; x < SCREEN_WIDTH; x += 3) {
-                int y_offset = rand() % (peak_height / 2) - (peak_height / 4);
-                int current_height = (int)((float)peak_height * ((float)(x - SCREEN_WIDTH / 2) / (SCREEN_WIDTH / 2))) + y_offset;
-                if (current_height < 1) current_height = 1;
-                D1306_DrawSquare(gDisplay, x, mountain_base_y - current_height, 2, current_height);
-                if (rand() % 10 < 3) D1306_DrawPixel(gDisplay, x + rand()%2, mountain_base_y - current_height - (rand()%5 + 1));
-            }
-
-            int char_width = 5; const char* title_chaos = "CHAOS"; const char* title_climb = "CLIMB";
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - (strlen(title_chaos) * char_width)) / 2, 8, 1, title_chaos);
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - (strlen(title_climb) * char_width)) / 2, 16, 1, title_climb);
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - (strlen("A: INICIAR") * char_width)) / 2, 45, 1, "A: INICIAR");
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - (strlen("B: CONFIG") * char_width)) / 2, 55, 1, "B: CONFIG");
-
-        } else if (gCurrentGameState == GAME_STATE_PLAY) {
-            D1306_DrawSquare(gDisplay, gPlayerPos[0], gPlayerPos[1], PLAYER_WIDTH, PLAYER_HEIGHT);
-            for (int i = 0; i < NUM_PLATFORMS; i++) {
-                D1306_DrawSquare(gDisplay, gPlatforms[i].x, gPlatforms[i].y,
-                                 gPlatforms[i].width, gPlatforms[i].height);
-                if (!gPlatforms[i].is_moving) {
-                    for (int y_fill = gPlatforms[i].y + gPlatforms[i].height; y_fill < SCREEN_HEIGHT; y_fill += 2) {
-                        for (int x_fill = gPlatforms[i].x; x_fill < gPlatforms[i].x + gPlatforms[i].width; x_fill +=2) {
-                            D1306_DrawPixel(gDisplay, x_fill, y_fill);
-                        }
-                    }
-                }
-            }
-        } else if (gCurrentGameState == GAME_STATE_CONFIG) {
-            int char_width = 5;
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - (strlen("CONFIG") * char_width)) / 2, 10, 1, "CONFIG");
-            sprintf(str_buffer, "VELOC: %d", gPlayerSpeed);
-            D1306_DrawString(gDisplay, 10, 30, 1, str_buffer);
-            D1306_DrawString(gDisplay, 10, 40, 1, "A: + B: -");
-            D1306_DrawString(gDisplay, 10, 50, 1, "SEGURE B P/ SAIR");
-
-            if (b_press_start_time_us != 0 && !b_long_pressed_triggered) {
-                uint64_t elapsed_time_us = time_us_64() - b_press_start_time_us;
-                int progress_width = (int)((float)elapsed_time_us / (LONG_PRESS_TIME_MS * 1000.0f) * SCREEN_WIDTH);
-                if (progress_width > SCREEN_WIDTH) progress_width = SCREEN_WIDTH;
-                D1306_DrawSquare(gDisplay, 0, 60, progress_width, 2);
-            }
-        } else if (gCurrentGameState == GAME_STATE_GAME_OVER) {
-            int gameover_char_width = 5; int gameover_scale = 2;
-            const char* game_over_text = "GAME OVER";
-            int actual_text_width_pixels = strlen(game_over_text) * gameover_char_width * gameover_scale;
-            int actual_text_height_pixels = 8 * gameover_scale;
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - actual_text_width_pixels) / 2,
-                             (SCREEN_HEIGHT - actual_text_height_pixels) / 2, gameover_scale, game_over_text);
-        } else if (gCurrentGameState == GAME_STATE_LEVEL_COMPLETE) {
-            int char_width = 5; int scale = 2;
-            const char* msg1 = "NIVEL";
-            const char* msg2 = "COMPLETO!";
-            int actual_text_width_pixels1 = strlen(msg1) * char_width * scale;
-            int actual_text_width_pixels2 = strlen(msg2) * char_width * scale;
-            int actual_text_height_pixels = 8 * scale; // Altura de uma linha de texto na escala 2
-
-            // Centraliza "NIVEL COMPLETO!" em duas linhas
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - actual_text_width_pixels1) / 2,
-                             (SCREEN_HEIGHT / 2) - actual_text_height_pixels + 5, scale, msg1); // Ajuste Y
-            D1306_DrawString(gDisplay, (SCREEN_WIDTH - actual_text_width_pixels2) / 2,
-                             (SCREEN_HEIGHT / 2) + 5, scale, msg2); // Ajuste Y
+#if CHAOS_POWER_SAVE
+        if (gAsleep) PowerDisplaySleep();
+#endif
+        uint64_t start_us = time_us_64();
+        bool drawn = AMP_BeginFrame(&canvas, start_us);
+        if (drawn) {
+#if CHAOS_TRACE
+            TRACE_Record(TRACE_FRAME_START, 0);
+#endif
+            GAME_Render(&canvas, start_us);
+            AMP_SubmitFrame(&canvas);
+#if CHAOS_TRACE
+            TRACE_Record(TRACE_FRAME_END, 0);
+#endif
         }
+        DisplayWait(drawn);
+    }
+}
+#else
+void TASK_Display() {
+    gDisplay = D1306_Init(gDisplayConfig);
+
+    while (true) {
+#if CHAOS_POWER_SAVE
+        if (gAsleep) PowerDisplaySleep();
+#endif
+        uint64_t start_us = time_us_64();
+#if CHAOS_TRACE
+        TRACE_Record(TRACE_FRAME_START, 0);
+#endif
+        GAME_Render(gDisplay, start_us);
         D1306_Show(gDisplay);
-        vTaskDelay(pdMS_TO_TICKS(30));
+#if CHAOS_TRACE
+        TRACE_Record(TRACE_FRAME_END, 0);
+#endif
+#if CHAOS_TASK_STATS
+        STATS_FrameSent((uint32_t)start_us, (uint32_t)time_us_64());
+#endif
+        DisplayWait(true);
     }
 }
+#endif
 
 void TASK_ButtonControl() {
     GPIO_CONFIG_t cfg_button_a = { .pin = BUTTON_A_PIN, .direction = 0, .logic = 1, .mode = 1 };
     GPIO_CONFIG_t cfg_button_b = { .pin = BUTTON_B_PIN, .direction = 0, .logic = 1, .mode = 1 };
     GPIO_t* button_a = GPIO_Init(cfg_button_a);
     GPIO_t* button_b = GPIO_Init(cfg_button_b);
-    static bool lastStateButtonA = false; static bool lastStateButtonB = false;
-    bool currentStateA; bool currentStateB; static uint64_t b_click_start_time_us = 0;
+#if CHAOS_POWER_SAVE
+    // Com os dois botões soltos não há o que amostrar: a tarefa dorme até a próxima borda
+    GPIO_SetIrq(button_a, true, PowerButtonIrq);
+    GPIO_SetIrq(button_b, true, PowerButtonIrq);
+    uint64_t last_activity_us = time_us_64();
+    GAME_STATE_t last_state = gCurrentGameState;
+#endif
 
     while (true) {
-        currentStateA = !GPIO_GetInput(button_a);
-        currentStateB = !GPIO_GetInput(button_b);
-
-        if (gCurrentGameState == GAME_STATE_MENU) {
-            if (currentStateA && !lastStateButtonA) {
-                gCurrentGameState = GAME_STATE_PLAY;
-                gLastLevelFinalPlatformY = -1; // Reset para início de nova partida
-                InitGameElements();
-                vTaskDelay(pdMS_TO_TICKS(STATE_TRANSITION_DEBOUNCE_MS));
-                currentStateA = !GPIO_GetInput(button_a); currentStateB = !GPIO_GetInput(button_b);
-            } else if (currentStateB && !lastStateButtonB) {
-                gCurrentGameState = GAME_STATE_CONFIG;
-                vTaskDelay(pdMS_TO_TICKS(STATE_TRANSITION_DEBOUNCE_MS));
-                currentStateA = !GPIO_GetInput(button_a); currentStateB = !GPIO_GetInput(button_b);
-                b_press_start_time_us = 0; b_long_pressed_triggered = false; b_click_start_time_us = 0;
-            }
-        } else if (gCurrentGameState == GAME_STATE_PLAY) {
-            if (currentStateA) { gPlayerPos[0] -= gPlayerSpeed; if (gPlayerPos[0] < 0) gPlayerPos[0] = 0; }
-            if (currentStateB) { gPlayerPos[0] += gPlayerSpeed; if (gPlayerPos[0] >= SCREEN_WIDTH - PLAYER_WIDTH) gPlayerPos[0] = SCREEN_WIDTH - PLAYER_WIDTH - 1; }
-        } else if (gCurrentGameState == GAME_STATE_CONFIG) {
-            if (currentStateA && !lastStateButtonA) { if (gPlayerSpeed < PLAYER_SPEED_MAX) gPlayerSpeed++; }
-            if (currentStateB && !lastStateButtonB) {
-                b_press_start_time_us = time_us_64(); b_click_start_time_us = time_us_64(); b_long_pressed_triggered = false;
-            } else if (currentStateB && lastStateButtonB) {
-                if (!b_long_pressed_triggered) {
-                    uint64_t elapsed_time_us = time_us_64() - b_press_start_time_us;
-                    if (elapsed_time_us >= (uint64_t)LONG_PRESS_TIME_MS * 1000) {
-                        gCurrentGameState = GAME_STATE_MENU; b_long_pressed_triggered = true; b_press_start_time_us = 0;
-                        vTaskDelay(pdMS_TO_TICKS(STATE_TRANSITION_DEBOUNCE_MS));
-                        currentStateA = !GPIO_GetInput(button_a); currentStateB = !GPIO_GetInput(button_b);
-                    }
-                }
-            } else if (!currentStateB && lastStateButtonB) {
-                uint64_t click_duration_us = time_us_64() - b_click_start_time_us;
-                if (!b_long_pressed_triggered && click_duration_us < (uint64_t)SHORT_CLICK_MAX_TIME_MS * 1000 && b_click_start_time_us != 0) {
-                    if (gPlayerSpeed > PLAYER_SPEED_MIN) gPlayerSpeed--;
-                }
-                b_press_start_time_us = 0; b_long_pressed_triggered = false; b_click_start_time_us = 0;
-            }
-        } else if (gCurrentGameState == GAME_STATE_GAME_OVER) {
-            if ((currentStateA && !lastStateButtonA) || (currentStateB && !lastStateButtonB)) {
-                gCurrentGameState = GAME_STATE_MENU;
-                gLastLevelFinalPlatformY = -1; // Reset para início de nova partida
-                vTaskDelay(pdMS_TO_TICKS(STATE_TRANSITION_DEBOUNCE_MS));
-                currentStateA = !GPIO_GetInput(button_a); currentStateB = !GPIO_GetInput(button_b);
-            }
-        } else if (gCurrentGameState == GAME_STATE_LEVEL_COMPLETE) {
-            if ((currentStateA && !lastStateButtonA) || (currentStateB && !lastStateButtonB)) {
-                gCurrentGameState = GAME_STATE_PLAY;
-                gLastLevelFinalPlatformY = gPlatforms[9].y; // Salva a altura da plataforma final
-                InitGameElements(); // Inicia o próximo nível
-                vTaskDelay(pdMS_TO_TICKS(STATE_TRANSITION_DEBOUNCE_MS));
-                currentStateA = !GPIO_GetInput(button_a); currentStateB = !GPIO_GetInput(button_b);
-            }
+        bool state_a = !GPIO_GetInput(button_a);
+        bool state_b = !GPIO_GetInput(button_b);
+        GAME_Input(state_a, state_b, time_us_64());
+#if CHAOS_TASK_STATS
+        // Latência medida a partir daqui: a mudança já foi aplicada ao jogo
+        if (state_a != gStateButtonA || state_b != gStateButtonB) STATS_InputEdge((uint32_t)time_us_64());
+#endif
+#if CHAOS_POWER_SAVE
+        if (state_a != gStateButtonA || state_b != gStateButtonB) xTaskNotifyGive(gTaskDisplay);
+#endif
+        gStateButtonA = state_a;
+        gStateButtonB = state_b;
+#if CHAOS_POWER_SAVE
+        // Durante o jogo a tela nunca apaga; uma troca de estado também conta como atividade
+        GAME_STATE_t state = gCurrentGameState;
+        if (state_a || state_b || state == GAME_STATE_PLAY || state != last_state) last_activity_us = time_us_64();
+        else if (time_us_64() - last_activity_us >= POWER_IDLE_TIMEOUT_MS * 1000ull) {
+            PowerSleep(button_a, button_b);
+            last_activity_us = time_us_64();
         }
-        lastStateButtonA = currentStateA; lastStateButtonB = currentStateB;
-        vTaskDelay(pdMS_TO_TICKS(50));
+        last_state = state;
+#endif
+        vTaskDelay(pdMS_TO_TICKS(GAME_INPUT_PERIOD_MS));
+#if CHAOS_POWER_SAVE
+        // Botão seguro segue amostrado a cada período (toque longo, movimento em PLAY). O período
+        // também filtra o ressalto: bordas dentro dele só adiantam a próxima amostra.
+        if (!state_a && !state_b) ulTaskNotifyTake(pdTRUE, PowerIdleWait(last_activity_us));
+#endif
     }
 }
 
 void TASK_PlatformMovement() {
     while(true) {
-        if (gCurrentGameState == GAME_STATE_PLAY) {
-            for (int i = 0; i < NUM_PLATFORMS; i++) {
-                if (gPlatforms[i].is_moving) {
-                    gPlatforms[i].move_counter++;
-                    if (gPlatforms[i].move_counter >= gPlatforms[i].speed_interval) {
-                        if (gPlatforms[i].direction == DIR_UP) {
-                            gPlatforms[i].y--;
-                            if (gPlatforms[i].y + gPlatforms[i].height < TOP_SCREEN_BOUNDARY) {
-                                gPlatforms[i].y = SCREEN_HEIGHT + PLATFORM_RESET_OFFSET + (rand() % 5);
-                            }
-                        } else {
-                            gPlatforms[i].y++;
-                            if (gPlatforms[i].y > SCREEN_HEIGHT) {
-                                gPlatforms[i].y = TOP_SCREEN_BOUNDARY - MOBILE_PLATFORM_HEIGHT - PLATFORM_RESET_OFFSET - (rand() % 5);
-                            }
-                        }
-                        gPlatforms[i].move_counter = 0;
-                    }
-                }
-            }
-        }
-        vTaskDelay(pdMS_TO_TICKS(10));
+        WaitForPlay();
+        GAME_StepPlatforms(time_us_64());
+        vTaskDelay(pdMS_TO_TICKS(GAME_LOGIC_PERIOD_MS));
     }
 }
 
 void TASK_GameLogic() {
     while(true) {
-        if (gCurrentGameState == GAME_STATE_PLAY) {
-            bool on_platform = false;
-            for (int i = 0; i < NUM_PLATFORMS; i++) {
-                PLATFORM_t *p = &gPlatforms[i];
-                if (gPlayerPos[0] < p->x + p->width && gPlayerPos[0] + PLAYER_WIDTH > p->x &&
-                    gPlayerPos[1] + PLAYER_HEIGHT >= p->y && gPlayerPos[1] + PLAYER_HEIGHT <= p->y + p->height &&
-                    gPlayerPos[1] + PLAYER_HEIGHT + PLAYER_GRAVITY > p->y) {
-                    gPlayerPos[1] = p->y - p->height; on_platform = true;
-                    if (p->is_moving) {
-                        if (p->move_counter == (p->speed_interval -1)) {
-                            if (p->direction == DIR_UP) { gPlayerPos[1]--; } else { gPlayerPos[1]++; }
-                        }
-                    }
-                    // Detecção de nível completo: Chegou na plataforma final
-                    if (i == 9) {
-                        printf("NIVEL COMPLETO!\n");
-                        gCurrentGameState = GAME_STATE_LEVEL_COMPLETE;
-                        break;
-                    }
-                    break;
-                }
-            }
-            if (!on_platform) { gPlayerPos[1] += PLAYER_GRAVITY; }
-            if (gPlayerPos[1] >= SCREEN_HEIGHT - PLAYER_HEIGHT && !on_platform) {
-                printf("!!! GAME OVER !!!\n");
-                gCurrentGameState = GAME_STATE_GAME_OVER;
-            }
-        }
-        vTaskDelay(pdMS_TO_TICKS(10));
+        WaitForPlay();
+        GAME_StepLogic();
+        vTaskDelay(pdMS_TO_TICKS(GAME_LOGIC_PERIOD_MS));
+    }
+}
+
+// Prioridade do idle: sorteia e resolve cada nível fora da trava do jogo, sem atrasar quadros nem entradas
+void TASK_Level() {
+    while(true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        GAME_BuildLevel();
+    }
+}
+
+#if CHAOS_TASK_STATS
+// Prioridade do idle: só imprime quando as tarefas do jogo estão esperando
+void TASK_Stats() {
+#if configNUMBER_OF_CORES > 1
+    for (BaseType_t core = 0; core < configNUMBER_OF_CORES; core++) STATS_Watch(xTaskGetIdleTaskHandleForCore(core), configMINIMAL_STACK_SIZE);
+#else
+    STATS_Watch(xTaskGetIdleTaskHandle(), configMINIMAL_STACK_SIZE);
+#endif
+    while(true) {
+        vTaskDelay(pdMS_TO_TICKS(STATS_PERIOD_MS));
+        STATS_Print();
+        STATS_PrintHeap();
+#if CHAOS_AMP
+        printf("amp: %lu quadros descartados (nucleo 1 ocupado)\n", (unsigned long)AMP_GetDroppedFrames());
+#endif
     }
 }
+#endif
+
+#if CHAOS_TRACE
+// Prioridade do idle: um 't' recebido pela USB imprime o anel (converta com chaos-trace2json)
+void TASK_Trace() {
+    TRACE_NumberTasks();
+    while(true) {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_POLL_MS));
+        if (getchar_timeout_us(0) == 't') TRACE_Dump();
+    }
+}
+#endif
+
+/****************************
+* HOOKS DO FREERTOS
+****************************/
+#if configCHECK_FOR_STACK_OVERFLOW
+// Chamado na troca de contexto quando a pilha da tarefa passou do limite: para tudo com o nome dela
+void vApplicationStackOverflowHook(TaskHandle_t task, char* name) {
+    (void)task;
+    panic("pilha estourada na tarefa %s", name);
+}
+#endif
+
+#if configUSE_MALLOC_FAILED_HOOK
+// pvPortMalloc devolveu NULL: mostra como estava o heap e o tamanho que não coube (só com CHAOS_TASK_STATS)
+void vApplicationMallocFailedHook(void) {
+#if CHAOS_TASK_STATS
+    STATS_PrintHeap();
+    panic("heap do FreeRTOS sem espaco para %lu bytes", (unsigned long)STATS_GetFailedMalloc());
+#else
+    panic("heap do FreeRTOS sem espaco (%lu bytes livres)", (unsigned long)xPortGetFreeHeapSize());
+#endif
+}
+#endif
+
+#if configSUPPORT_STATIC_ALLOCATION
+// Com alocação estática o kernel pede a memória do idle e do daemon de timers à aplicação
+void vApplicationGetIdleTaskMemory(StaticTask_t** buffer, StackType_t** stack, configSTACK_DEPTH_TYPE* depth) {
+    *buffer = &gIdleBuffer;
+    *stack = gIdleStack;
+    *depth = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t** buffer, StackType_t** stack, configSTACK_DEPTH_TYPE* depth) {
+    *buffer = &gTimerBuffer;
+    *stack = gTimerStack;
+    *depth = configTIMER_TASK_STACK_DEPTH;
+}
+
+#if configNUMBER_OF_CORES > 1
+// Com SMP, cada núcleo além do primeiro tem seu idle passivo
+void vApplicationGetPassiveIdleTaskMemory(StaticTask_t** buffer, StackType_t** stack, configSTACK_DEPTH_TYPE* depth, BaseType_t index) {
+    *buffer = &gPassiveIdleBuffers[index];
+    *stack = gPassiveIdleStacks[index];
+    *depth = configMINIMAL_STACK_SIZE;
+}
+#endif
+#endif
 
 /****************************
 * MAIN
 ****************************/
+// cores: máscara de núcleos permitidos, só usada com CHAOS_SMP
+static TaskHandle_t CreateTask(TaskFunction_t function, const char* name, uint32_t depth, UBaseType_t priority, UBaseType_t cores) {
+    TaskHandle_t handle;
+#if CHAOS_STATIC_ALLOC
+    assert(gTaskBuffersUsed < TASK_COUNT && gTaskStacksUsed + depth <= STACK_TOTAL);
+    handle = xTaskCreateStatic(function, name, depth, NULL, priority, &gTaskStacks[gTaskStacksUsed], &gTaskBuffers[gTaskBuffersUsed++]);
+    gTaskStacksUsed += depth;
+#else
+    xTaskCreate(function, name, depth, NULL, priority, &handle);
+#endif
+#if configUSE_CORE_AFFINITY && configNUMBER_OF_CORES > 1
+    vTaskCoreAffinitySet(handle, cores);
+#else
+    (void)cores;
+#endif
+#if CHAOS_TASK_STATS
+    STATS_Watch(handle, depth);
+#endif
+#if CHAOS_TRACE
+    TRACE_NumberTask(handle);
+#endif
+    return handle;
+}
+
 int main() {
-    stdio_init_all(); srand(time_us_64());
-    InitGameElements();
-    xTaskCreate(TASK_Display, "Display", 256, NULL, 1, NULL);
-    xTaskCreate(TASK_ButtonControl, "ButtonControl", 256, NULL, 1, NULL);
-    xTaskCreate(TASK_PlatformMovement, "PlatformMovement", 256, NULL, 1, NULL);
-    xTaskCreate(TASK_GameLogic, "GameLogic", 256, NULL, 1, NULL);
+    stdio_init_all();
+    uint32_t seed = time_us_64();
+    srand(seed); GAME_Init(seed);
+#if CHAOS_TRACE
+    TRACE_Init();
+#endif
+    GAME_SetStateHook(GameStateChanged);
+    GAME_SetLevelHook(LevelRequested);
+#if CHAOS_AMP
+    // Antes do escalonador: a inicialização do display espera 1 s e o I2C passa a ser só do núcleo 1
+    gDisplay = D1306_Init(gDisplayConfig);
+    AMP_Start(gDisplay);
+#endif
+    gTaskDisplay = CreateTask(TASK_Display, "Display", STACK_DISPLAY, 1, CORE_DISPLAY);
+    gTaskButtonControl = CreateTask(TASK_ButtonControl, "ButtonControl", STACK_BUTTON_CONTROL, 1, CORE_SIMULATION);
+    gTaskPlatformMovement = CreateTask(TASK_PlatformMovement, "PlatformMovement", STACK_PLATFORM_MOVEMENT, 1, CORE_SIMULATION);
+    gTaskGameLogic = CreateTask(TASK_GameLogic, "GameLogic", STACK_GAME_LOGIC, 1, CORE_SIMULATION);
+    gTaskLevel = CreateTask(TASK_Level, "Level", STACK_LEVEL, tskIDLE_PRIORITY, CORE_SIMULATION | CORE_DISPLAY);
+#if CHAOS_TASK_STATS
+    CreateTask(TASK_Stats, "Stats", STACK_STATS, tskIDLE_PRIORITY, CORE_SIMULATION | CORE_DISPLAY);
+#endif
+#if CHAOS_TRACE
+    CreateTask(TASK_Trace, "Trace", STACK_TRACE, tskIDLE_PRIORITY, CORE_SIMULATION | CORE_DISPLAY);
+#endif
     vTaskStartScheduler();
     while (1);
-}
\ No newline at end of file
+}
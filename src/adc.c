@@ -1,10 +1,16 @@
 #include <include/adc.h>
+#include <include/alloc.h>
+
+#if CHAOS_STATIC_ALLOC
+static ADC_t adc_pool[ADC_MAX_HANDLES];
+static size_t adc_pool_used;
+#endif
 
 ADC_t* ADC_Init( ADC_CONFIG_t cfg )
 {
     ADC_t* adc;
 
-    adc = (ADC_t*)malloc( sizeof ( ADC_t ) );
+    adc = HAL_ALLOC( ADC_t , adc_pool , adc_pool_used , HAL_ALLOC_ADC );
     
     assert( adc != NULL );
     assert( cfg.pin >= 26 && cfg.pin <= 29 ); // RP2040 usa 0 para 26,1 para 27, 2 para 28 e 3 para 29 
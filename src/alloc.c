@@ -0,0 +1,38 @@
+#include "alloc.h"
+
+static HAL_ALLOC_STATS_t hal_alloc_stats[HAL_ALLOC_TAGS];
+
+static const char* const hal_alloc_names[HAL_ALLOC_TAGS] = {
+    [HAL_ALLOC_GPIO] = "gpio",
+    [HAL_ALLOC_I2C] = "i2c",
+    [HAL_ALLOC_ADC] = "adc",
+    [HAL_ALLOC_JOYSTICK] = "joystick",
+    [HAL_ALLOC_D1306] = "d1306",
+};
+
+void* HAL_Malloc( size_t size , HAL_ALLOC_TAG_t tag )
+{
+    void* memory = malloc( size );
+
+    assert( tag < HAL_ALLOC_TAGS );
+
+    if( memory != NULL )
+    {
+        hal_alloc_stats[tag].bytes += size;
+        hal_alloc_stats[tag].count++;
+    }
+
+    return memory;
+}
+
+const HAL_ALLOC_STATS_t* HAL_GetAllocStats( HAL_ALLOC_TAG_t tag )
+{
+    assert( tag < HAL_ALLOC_TAGS );
+    return &hal_alloc_stats[tag];
+}
+
+const char* HAL_GetAllocName( HAL_ALLOC_TAG_t tag )
+{
+    assert( tag < HAL_ALLOC_TAGS );
+    return hal_alloc_names[tag];
+}
@@ -0,0 +1,84 @@
+#include "amp.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+#if CHAOS_TASK_STATS
+#include "stats.h"
+#endif
+
+// Byte extra antes de cada quadro: o 0x40 de dados que D1306_Show envia junto
+static uint8_t amp_frames[AMP_FRAMES][D1306_MAX_BUFSIZE + 1];
+static volatile bool amp_busy[AMP_FRAMES]; // true do envio pelo núcleo 0 até o fim da transmissão no núcleo 1
+static uint32_t amp_start_us[AMP_FRAMES];
+static volatile uint32_t amp_dropped;
+static D1306_t* amp_display;
+
+// Núcleo 1: sem escalonador nem interrupções do FreeRTOS, só espera quadros e os transmite.
+// A volta (quadro livre) é por amp_busy: no sentido núcleo 1 -> 0 a FIFO pertence ao port do FreeRTOS.
+static void AMP_Core1( void )
+{
+    while( true )
+    {
+        uint32_t index = multicore_fifo_pop_blocking();
+        assert( index < AMP_FRAMES );
+
+        amp_display->buffer = amp_frames[index] + 1;
+        D1306_Show( amp_display );
+
+#if CHAOS_TASK_STATS
+        STATS_FrameSent( amp_start_us[index] , (uint32_t)time_us_64() );
+#endif
+        __mem_fence_release();
+        amp_busy[index] = false;
+    }
+}
+
+void AMP_Start( D1306_t* display )
+{
+    assert( display->bufsize <= D1306_MAX_BUFSIZE );
+
+    amp_display = display;
+    multicore_launch_core1( AMP_Core1 );
+}
+
+bool AMP_BeginFrame( D1306_t* canvas , uint64_t now_us )
+{
+    for( int i = 0 ; i < AMP_FRAMES ; ++i )
+    {
+        if( !amp_busy[i] )
+        {
+            __mem_fence_acquire();
+            canvas->buffer = amp_frames[i] + 1;
+            amp_start_us[i] = (uint32_t)now_us;
+            return true;
+        }
+    }
+
+    amp_dropped++;
+    return false;
+}
+
+void AMP_SubmitFrame( D1306_t* canvas )
+{
+    uint32_t index = ( canvas->buffer - 1 - amp_frames[0] ) / sizeof( amp_frames[0] );
+    assert( index < AMP_FRAMES );
+
+    amp_busy[index] = true;
+    __mem_fence_release();
+    multicore_fifo_push_blocking( index ); // Nunca espera: no máximo AMP_FRAMES quadros na FIFO de 8
+}
+
+bool AMP_IsIdle( void )
+{
+    for( int i = 0 ; i < AMP_FRAMES ; ++i )
+    {
+        if( amp_busy[i] ) return false;
+    }
+
+    return true;
+}
+
+uint32_t AMP_GetDroppedFrames( void )
+{
+    return amp_dropped;
+}
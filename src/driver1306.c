@@ -1,9 +1,16 @@
 #include "driver1306.h"
 #include <string.h>
 #include <stdio.h>
+#include "alloc.h"
 
 extern const uint8_t font_8x5[];
 
+#if CHAOS_STATIC_ALLOC
+static D1306_t d1306_pool[D1306_MAX_HANDLES];
+static size_t d1306_pool_used;
+static uint8_t d1306_buffers[D1306_MAX_HANDLES][D1306_MAX_BUFSIZE + 1];
+#endif
+
 inline static void D1306_Write( D1306_t* D1306 , uint8_t val )
 {
     uint8_t buffer[2] = { 0x00 , val };
@@ -14,7 +21,7 @@ D1306_t * D1306_Init( D1306_CONFIG_t cfg )
 {
     D1306_t* D1306;
 
-    D1306 = (D1306_t*)malloc( sizeof ( D1306_t ) );
+    D1306 = HAL_ALLOC( D1306_t , d1306_pool , d1306_pool_used , HAL_ALLOC_D1306 );
     
     assert( D1306 != NULL );
     sleep_ms(1000);
@@ -25,7 +32,13 @@ D1306_t * D1306_Init( D1306_CONFIG_t cfg )
     D1306->pages = cfg.height/8;
 
     D1306->bufsize = (D1306->pages)*(D1306->width);
-    D1306->buffer = malloc( D1306->bufsize );
+    // Um byte a mais antes do quadro: o 0x40 de dados vai junto na mesma transação (D1306_Show)
+#if CHAOS_STATIC_ALLOC
+    assert( D1306->bufsize <= D1306_MAX_BUFSIZE );
+    D1306->buffer = d1306_buffers[d1306_pool_used - 1];
+#else
+    D1306->buffer = HAL_Malloc( D1306->bufsize + 1 , HAL_ALLOC_D1306 );
+#endif
     D1306->font = font_8x5;
 
     assert( D1306->buffer != NULL );
@@ -79,6 +92,11 @@ void D1306_Invert( D1306_t* D1306 , uint8_t inv )
     D1306_Write( D1306 , SET_NORM_INV | (inv & 1));
 }
 
+void D1306_SetPower( D1306_t* D1306 , bool on )
+{
+    D1306_Write( D1306 , SET_DISP | ( on ? 1 : 0 ) );
+}
+
 void D1306_Show( D1306_t* D1306 )
 {
     uint8_t payload[] = { SET_COL_ADDR , 0 , D1306->width - 1 , SET_PAGE_ADDR , 0 , D1306->pages - 1 };
@@ -147,4 +165,15 @@ void D1306_DrawSquare( D1306_t* D1306 , uint32_t x, uint32_t y, uint32_t width,
     for( uint32_t i = 0; i < width ; ++i )
         for( uint32_t j = 0 ; j < height ; ++j )
             D1306_DrawPixel( D1306 , x + i, y + j );
+}
+
+// Combina (OR) colunas de 8 pixels já no formato de página diretamente no buffer
+void D1306_BlitPage( D1306_t* D1306 , uint32_t x, uint32_t page, const uint8_t* columns, uint32_t count )
+{
+    if( page >= D1306->pages || x >= D1306->width ) return;
+    if( x + count > D1306->width ) count = D1306->width - x;
+
+    uint8_t* dst = &D1306->buffer[x + D1306->width * page];
+    for( uint32_t i = 0 ; i < count ; ++i )
+        dst[i] |= columns[i];
 }
\ No newline at end of file
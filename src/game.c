@@ -0,0 +1,727 @@
+#include "game.h"
+#include "random.h"
+#include "solver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CHAOS_RTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+// Cada chamada da API roda inteira sob a trava: com SMP, o Display compõe no outro núcleo em paralelo
+#define GAME_LOCK() xSemaphoreTake(gGameLock, portMAX_DELAY)
+#define GAME_UNLOCK() xSemaphoreGive(gGameLock)
+#else
+#define GAME_LOCK()
+#define GAME_UNLOCK()
+#endif
+
+#if CHAOS_GAME_LOG
+#define GAME_LOG(...) printf(__VA_ARGS__)
+#else
+#define GAME_LOG(...)
+#endif
+
+#if CHAOS_TRACE
+#include "trace.h"
+// Colisão no trace: o personagem pousou numa plataforma móvel diferente da do tick anterior
+static int gTraceSupport = PLATFORM_NONE;
+#define GAME_TRACE_SUPPORT(i) do { if ((i) != PLATFORM_NONE && (i) != gTraceSupport) TRACE_Record(TRACE_COLLISION, (i)); gTraceSupport = (i); } while (0)
+#else
+#define GAME_TRACE_SUPPORT(i)
+#endif
+
+/****************************
+* DEFINES
+****************************/
+#define PLAYER_SPEED_DEFAULT PLAYER_WIDTH
+#define PLAYER_SPEED_MIN 1
+#define PLAYER_SPEED_MAX 8
+
+#define MOBILE_PLATFORM_WIDTH 20
+#define MOBILE_PLATFORM_HEIGHT 2 // Espessura das plataformas móveis
+
+#define STATIC_PLATFORM_DEFAULT_WIDTH (3 * TILE_SIZE) // Plataformas fixas são terreno no tilemap
+#define STATIC_PLATFORM_HEIGHT TILE_GROUND_BAND // Altura das plataformas fixas
+
+#define NUM_MOVING_COLUMNS 12 // Comprimento do nível em colunas de plataformas móveis
+#define NUM_MOVING_PLATFORMS (NUM_MOVING_COLUMNS * 2)
+
+#define MIN_MOVING_PLATFORM_INTERVAL 1 // Plataforma mais rápida
+#define MAX_MOVING_PLATFORM_INTERVAL 5 // Plataforma mais lenta
+
+#define HORIZONTAL_SPACING 1
+
+#define LEVEL_MAX_ATTEMPTS 8 // Sorteios por nível até o solver achar um caminho; depois, a ponte de BuildBridgeLevel
+
+#define TOP_SCREEN_BOUNDARY 0
+#define BOTTOM_SCREEN_BOUNDARY (SCREEN_HEIGHT - MOBILE_PLATFORM_HEIGHT)
+
+#define PLATFORM_RESET_OFFSET 10
+
+#define MIN_STATIC_PLATFORM_Y (SCREEN_HEIGHT - 40)
+#define MAX_STATIC_PLATFORM_Y (SCREEN_HEIGHT - STATIC_PLATFORM_HEIGHT)
+
+#define INITIAL_PAIR_BOTTOM_Y (SCREEN_HEIGHT - MOBILE_PLATFORM_HEIGHT - 5)
+#define INITIAL_PAIR_TOP_Y_OFFSET (SCREEN_HEIGHT / 2 - MOBILE_PLATFORM_HEIGHT / 2)
+
+#define VERTICAL_COLUMN_CONSTANT_GAP (INITIAL_PAIR_BOTTOM_Y - INITIAL_PAIR_TOP_Y_OFFSET)
+
+// Modo infinito: anel de pedaços (uma coluna cada) gerados à frente da câmera
+#define ENDLESS_CHUNK_SLOTS 16
+#define ENDLESS_PLATFORMS_PER_CHUNK 2
+#define ENDLESS_REST_INTERVAL 6 // A cada N pedaços, uma plataforma fixa de descanso
+#define ENDLESS_LOOKAHEAD SCREEN_WIDTH // Quanto do mundo é mantido gerado à direita da tela
+#define ENDLESS_RETIRE_MARGIN MOBILE_PLATFORM_WIDTH // Quanto atrás da câmera um pedaço é descartado
+#define ENDLESS_REBASE_SPAN (8 * PLATFORM_BUCKET_SPAN) // Recentraliza o mundo antes do int16 estourar (múltiplo de TILEMAP_SPAN)
+
+#define INTERP_MAX_JUMP (2 * PLAYER_SPEED_MAX) // Saltos maiores (volta na tela, novo nível, recentralização) não são interpolados
+
+#define LONG_PRESS_TIME_MS 1000
+#define SHORT_CLICK_MAX_TIME_MS 200
+
+/****************************
+* VARIABLES
+****************************/
+CHAOS_GAME_TLS GAME_STATE_t gCurrentGameState = GAME_STATE_MENU;
+CHAOS_GAME_TLS GAME_MODE_t gGameMode = GAME_MODE_LEVELS;
+
+CHAOS_GAME_TLS int gPlayerSpeed = PLAYER_SPEED_DEFAULT;
+
+static CHAOS_GAME_TLS uint64_t b_press_start_time_us = 0;
+static CHAOS_GAME_TLS bool b_long_pressed_triggered = false;
+static CHAOS_GAME_TLS uint64_t a_press_start_time_us = 0;
+static CHAOS_GAME_TLS uint64_t b_click_start_time_us = 0;
+static CHAOS_GAME_TLS bool lastStateButtonA = false;
+static CHAOS_GAME_TLS bool lastStateButtonB = false;
+static CHAOS_GAME_TLS uint64_t input_blocked_until_us = 0; // Debounce após mudança de estado
+
+static CHAOS_GAME_TLS int gLastLevelFinalPlatformY = -1; // -1: Primeira partida
+static CHAOS_GAME_TLS uint32_t gLevelRandom; // Sorteios dos níveis: mesma semente e entradas, mesma partida
+static CHAOS_GAME_TLS GAME_STATE_HOOK_t gStateHook;
+static CHAOS_GAME_TLS GAME_LEVEL_HOOK_t gLevelHook;
+
+// Pedido de nível: feito sob a trava, montado fora dela por GAME_BuildLevel. Com um pedido pendente
+// a tela fica onde está e as entradas são ignoradas, então nada mais sorteia de gLevelRandom até a troca.
+static CHAOS_GAME_TLS bool gLevelPending = false;
+static CHAOS_GAME_TLS int gPendingStartY;
+static CHAOS_GAME_TLS int gPendingSpeed;
+static CHAOS_GAME_TLS uint32_t gPendingRandom;
+static CHAOS_GAME_TLS GAME_LEVEL_t gNextLevel; // Só quem monta o nível escreve aqui
+
+CHAOS_GAME_TLS int gPlayerPos[2]; // Coordenadas de mundo
+CHAOS_GAME_TLS int gCameraX = 0;  // Coordenada de mundo da borda esquerda da tela
+CHAOS_GAME_TLS int gWorldWidth = 0; // Largura do nível em coordenadas de mundo (pode exceder a tela)
+CHAOS_GAME_TLS PLATFORMS_t gPlatforms; // Plataformas móveis
+CHAOS_GAME_TLS TILEMAP_t gTerrain;     // Plataformas fixas e o terreno sob elas
+CHAOS_GAME_TLS int gGoalX = -1;        // Terreno a partir deste x completa o nível (-1 no modo infinito)
+CHAOS_GAME_TLS int gGoalY = 0;
+
+// Anel do modo infinito: pedaços [gEndlessTail, gEndlessHead) estão vivos
+static CHAOS_GAME_TLS uint32_t gEndlessHead = 0;
+static CHAOS_GAME_TLS uint32_t gEndlessTail = 0;
+static CHAOS_GAME_TLS int gEndlessNextX = 0;
+static CHAOS_GAME_TLS int gEndlessChunkStart[ENDLESS_CHUNK_SLOTS];
+static CHAOS_GAME_TLS int gEndlessChunkEnd[ENDLESS_CHUNK_SLOTS];
+static CHAOS_GAME_TLS int gEndlessGroundY = 0; // Altura do terreno de descanso mais recente
+
+// Estado do tick anterior, para o quadro interpolar até o atual conforme o instante da renderização
+static CHAOS_GAME_TLS bool gInterpValid = false;
+static CHAOS_GAME_TLS uint64_t gInterpTickUs = 0; // Instante do último tick de plataformas
+static CHAOS_GAME_TLS int gInterpPlayer[2];
+static CHAOS_GAME_TLS int gInterpCameraX;
+static CHAOS_GAME_TLS int16_t gInterpPlatformY[PLATFORM_MAX_COUNT];
+
+#if CHAOS_RTOS
+static SemaphoreHandle_t gGameLock;
+#if configSUPPORT_STATIC_ALLOCATION
+static StaticSemaphore_t gGameLockBuffer;
+#endif
+#endif
+
+const PLATFORM_BOUNDS_t gPlatformBounds = {
+    .top = TOP_SCREEN_BOUNDARY, .bottom = SCREEN_HEIGHT, .reset_offset = PLATFORM_RESET_OFFSET
+};
+
+/****************************
+* FUNÇÕES INTERNAS DO JOGO
+****************************/
+static void UpdateCamera(void) {
+    // Mantém o personagem centralizado, sem sair dos limites do mundo
+    int camera_x = gPlayerPos[0] + PLAYER_WIDTH / 2 - SCREEN_WIDTH / 2;
+    if (gGameMode == GAME_MODE_LEVELS && camera_x > gWorldWidth - SCREEN_WIDTH) camera_x = gWorldWidth - SCREEN_WIDTH;
+    if (camera_x < 0) camera_x = 0;
+    // Modo infinito: a câmera só avança, pois os pedaços que ficaram para trás já foram descartados
+    if (gGameMode == GAME_MODE_ENDLESS && camera_x < gCameraX) camera_x = gCameraX;
+    gCameraX = camera_x;
+}
+
+static int RandomStaticPlatformY(uint32_t* random) {
+    return RANDOM_Below(random, MAX_STATIC_PLATFORM_Y - MIN_STATIC_PLATFORM_Y + 1) + MIN_STATIC_PLATFORM_Y;
+}
+
+// Adiciona o par de plataformas móveis de uma coluna; retorna o x da próxima coluna.
+// Antes de um terreno, a coluna é alargada para que ele comece alinhado aos tiles.
+static int AddMovingColumn(PLATFORMS_t* platforms, uint32_t* random, int first_slot, int x, bool terrain_next) {
+    int width = MOBILE_PLATFORM_WIDTH;
+    if (terrain_next) width += (TILE_SIZE - (x + width + HORIZONTAL_SPACING) % TILE_SIZE) % TILE_SIZE;
+
+    PLATFORM_CONFIG_t pair = {
+        .x = x, .y = INITIAL_PAIR_BOTTOM_Y,
+        .width = width, .height = MOBILE_PLATFORM_HEIGHT, .is_moving = true,
+        .direction = (RANDOM_Below(random, 2) == 0) ? DIR_UP : DIR_DOWN,
+        .speed_interval = RANDOM_Below(random, MAX_MOVING_PLATFORM_INTERVAL - MIN_MOVING_PLATFORM_INTERVAL + 1) + MIN_MOVING_PLATFORM_INTERVAL
+    };
+    PLATFORMS_Set(platforms, first_slot, pair);
+    pair.y = INITIAL_PAIR_TOP_Y_OFFSET;
+    PLATFORMS_Set(platforms, first_slot + 1, pair);
+
+    return x + width + HORIZONTAL_SPACING;
+}
+
+static void SpawnPlayer(int ground_x, int ground_y) {
+    gPlayerPos[0] = ground_x + (STATIC_PLATFORM_DEFAULT_WIDTH / 2) - (PLAYER_WIDTH / 2);
+    gPlayerPos[1] = ground_y - PLAYER_HEIGHT;
+    UpdateCamera();
+    gInterpValid = false; // Nível novo: nada para interpolar até o primeiro tick
+}
+
+// Monta um nível em level sem tocar no estado do jogo: só level e random mudam
+static void BuildLevel(GAME_LEVEL_t* level, uint32_t* random, int start_y) {
+    PLATFORMS_Clear(&level->platforms);
+    TILEMAP_Clear(&level->terrain);
+    level->platforms.random = RANDOM_Seed(RANDOM_Next(random));
+
+    // Plataforma inicial
+    TILEMAP_FillGround(&level->terrain, 0, start_y, STATIC_PLATFORM_DEFAULT_WIDTH);
+
+    // Colunas de plataformas móveis, um par em sincronia por coluna
+    int column_x = STATIC_PLATFORM_DEFAULT_WIDTH + HORIZONTAL_SPACING;
+    for (int column = 0; column < NUM_MOVING_COLUMNS; column++) {
+        column_x = AddMovingColumn(&level->platforms, random, column * 2, column_x, column == NUM_MOVING_COLUMNS - 1);
+    }
+
+    // Plataforma final
+    level->goal_x = column_x;
+    level->goal_y = RandomStaticPlatformY(random);
+    TILEMAP_FillGround(&level->terrain, level->goal_x, level->goal_y, STATIC_PLATFORM_DEFAULT_WIDTH);
+    level->world_width = level->goal_x + STATIC_PLATFORM_DEFAULT_WIDTH;
+
+    // Posição inicial do personagem na primeira plataforma fixa
+    level->player_x = (STATIC_PLATFORM_DEFAULT_WIDTH / 2) - (PLAYER_WIDTH / 2);
+    level->player_y = start_y - PLAYER_HEIGHT;
+}
+
+// Reserva sobre o último sorteio: sem plataformas móveis, chão contínuo na altura inicial até a meta.
+// Só andando para a direita se chega lá em qualquer velocidade e altura (conferido com o solver).
+static void BuildBridgeLevel(GAME_LEVEL_t* level, int start_y) {
+    PLATFORMS_Clear(&level->platforms);
+    TILEMAP_Clear(&level->terrain);
+    TILEMAP_FillGround(&level->terrain, 0, start_y, level->world_width);
+    level->goal_y = start_y;
+}
+
+// Sorteia níveis até o solver achar um caminho. O feixe curto aceita a maioria barato; quem ele
+// não resolve passa pela busca completa antes de ser descartado, para não favorecer os fáceis.
+// Sem nenhum resolvido, entra a ponte: nunca sai um nível não conferido.
+// Como BuildLevel, não lê nem escreve o estado do jogo: pode rodar fora da trava.
+static void GenerateLevel(GAME_LEVEL_t* level, uint32_t* random, int start_y, int speed) {
+    for (int attempt = 1; attempt <= LEVEL_MAX_ATTEMPTS; attempt++) {
+        BuildLevel(level, random, start_y);
+        SOLVER_RESULT_t result = SOLVER_Run(level, speed, SOLVER_MAX_TICKS, SOLVER_LEVEL_EXPANDED, SOLVER_LEVEL_STATES);
+        if (!result.solvable) result = SOLVER_Run(level, speed, SOLVER_MAX_TICKS, SOLVER_MAX_EXPANDED, SOLVER_MAX_STATES);
+        if (result.solvable) {
+            GAME_LOG("Nivel resolvido na tentativa %d: %lu ticks, %lu estados\n", attempt,
+                     (unsigned long)result.ticks, (unsigned long)result.expanded);
+            return;
+        }
+    }
+    GAME_LOG("Nenhum nivel resolvido em %d tentativas: ponte\n", LEVEL_MAX_ATTEMPTS);
+    BuildBridgeLevel(level, start_y);
+}
+
+// Passa a jogar o nível dado, no seu tick inicial
+static void LoadLevel(const GAME_LEVEL_t* level) {
+    memcpy(&gPlatforms, &level->platforms, sizeof(gPlatforms));
+    memcpy(&gTerrain, &level->terrain, sizeof(gTerrain));
+    gGoalX = level->goal_x; gGoalY = level->goal_y; gWorldWidth = level->world_width;
+    gPlayerPos[0] = level->player_x; gPlayerPos[1] = level->player_y;
+    UpdateCamera();
+    gInterpValid = false; // Nível novo: nada para interpolar até o primeiro tick
+}
+
+// Primeiro nível, montado na hora por GAME_Init
+static void InitGameElements(void) {
+    int start_y = RandomStaticPlatformY(&gLevelRandom);
+    GenerateLevel(&gNextLevel, &gLevelRandom, start_y, gPlayerSpeed);
+    LoadLevel(&gNextLevel);
+}
+
+// Gera o próximo pedaço do modo infinito no slot livre do anel
+static void GenerateEndlessChunk(void) {
+    int slot = gEndlessHead % ENDLESS_CHUNK_SLOTS;
+    int x = gEndlessNextX;
+
+    gEndlessChunkStart[slot] = x;
+    if (gEndlessHead % ENDLESS_REST_INTERVAL == 0) {
+        gEndlessGroundY = RandomStaticPlatformY(&gLevelRandom);
+        TILEMAP_FillGround(&gTerrain, x, gEndlessGroundY, STATIC_PLATFORM_DEFAULT_WIDTH);
+        x += STATIC_PLATFORM_DEFAULT_WIDTH + HORIZONTAL_SPACING;
+    } else {
+        x = AddMovingColumn(&gPlatforms, &gLevelRandom, slot * ENDLESS_PLATFORMS_PER_CHUNK, x, (gEndlessHead + 1) % ENDLESS_REST_INTERVAL == 0);
+    }
+
+    gEndlessChunkEnd[slot] = x;
+    gEndlessNextX = x;
+    gEndlessHead++;
+}
+
+// Trabalho incremental do modo infinito: no máximo um pedaço descartado e um gerado por tick
+static void StepEndlessGeneration(void) {
+    if (gEndlessHead != gEndlessTail) {
+        int slot = gEndlessTail % ENDLESS_CHUNK_SLOTS;
+        if (gEndlessChunkEnd[slot] < gCameraX - ENDLESS_RETIRE_MARGIN) {
+            if (gEndlessTail % ENDLESS_REST_INTERVAL == 0) {
+                TILEMAP_ClearColumns(&gTerrain, gEndlessChunkStart[slot], STATIC_PLATFORM_DEFAULT_WIDTH);
+            } else {
+                for (int k = 0; k < ENDLESS_PLATFORMS_PER_CHUNK; k++) {
+                    PLATFORMS_Remove(&gPlatforms, slot * ENDLESS_PLATFORMS_PER_CHUNK + k);
+                }
+            }
+            gEndlessTail++;
+        }
+    }
+
+    if (gEndlessHead - gEndlessTail < ENDLESS_CHUNK_SLOTS &&
+        gEndlessNextX < gCameraX + SCREEN_WIDTH + ENDLESS_LOOKAHEAD) {
+        GenerateEndlessChunk();
+    }
+
+    // Desloca o mundo por um múltiplo do vão dos baldes e do anel de tiles: nenhum índice muda.
+    // Sob a trava do jogo, como toda a lógica: entrada e quadro nunca veem o meio do deslocamento.
+    if (gCameraX >= ENDLESS_REBASE_SPAN) {
+        PLATFORMS_ShiftX(&gPlatforms, ENDLESS_REBASE_SPAN);
+        for (int k = 0; k < ENDLESS_CHUNK_SLOTS; k++) {
+            gEndlessChunkStart[k] -= ENDLESS_REBASE_SPAN;
+            gEndlessChunkEnd[k] -= ENDLESS_REBASE_SPAN;
+        }
+        gEndlessNextX -= ENDLESS_REBASE_SPAN;
+        gPlayerPos[0] -= ENDLESS_REBASE_SPAN;
+        gCameraX -= ENDLESS_REBASE_SPAN;
+    }
+}
+
+static void InitEndlessElements(void) {
+    PLATFORMS_Clear(&gPlatforms);
+    TILEMAP_Clear(&gTerrain);
+    gPlatforms.random = RANDOM_Seed(RANDOM_Next(&gLevelRandom));
+    gGoalX = -1;
+    gEndlessHead = 0; gEndlessTail = 0; gEndlessNextX = 0;
+    gCameraX = 0;
+
+    // O pedaço 0 é sempre terreno: ponto de partida
+    GenerateEndlessChunk();
+    int start_y = gEndlessGroundY;
+    while (gEndlessHead < ENDLESS_CHUNK_SLOTS && gEndlessNextX < SCREEN_WIDTH + ENDLESS_LOOKAHEAD) {
+        GenerateEndlessChunk();
+    }
+
+    SpawnPlayer(0, start_y);
+}
+
+// Terreno sob algum pixel da largura do personagem (a partir de px) na linha y
+static bool TerrainUnder(const TILEMAP_t* terrain, int px, int y) {
+    for (int x = px; x < px + PLAYER_WIDTH; x++) {
+        if (TILEMAP_IsSolid(terrain, x, y)) return true;
+    }
+    return false;
+}
+
+// Toda troca de estado fora de GAME_Init passa por aqui, para o gancho ver entradas e saídas
+static void SetState(GAME_STATE_t state) {
+    GAME_STATE_t previous = gCurrentGameState;
+    gCurrentGameState = state;
+    if (gStateHook && state != previous) gStateHook(previous, state);
+}
+
+// Sob a trava: o nível montado passa a valer e a partida começa
+static void EnterPendingLevel(void) {
+    gLevelRandom = gPendingRandom;
+    LoadLevel(&gNextLevel);
+    gLevelPending = false;
+    SetState(GAME_STATE_PLAY);
+}
+
+// Pede o próximo nível do modo níveis, começando na altura em que o anterior terminou.
+// Sem gancho ele é montado aqui mesmo; com gancho, GAME_BuildLevel o monta e faz a troca.
+static void RequestLevel(void) {
+    gPendingStartY = (gLastLevelFinalPlatformY != -1) ? gLastLevelFinalPlatformY : RandomStaticPlatformY(&gLevelRandom);
+    gPendingSpeed = gPlayerSpeed;
+    gPendingRandom = gLevelRandom;
+    gLevelPending = true;
+    if (gLevelHook) {
+        gLevelHook();
+        return;
+    }
+    GenerateLevel(&gNextLevel, &gPendingRandom, gPendingStartY, gPendingSpeed);
+    EnterPendingLevel();
+}
+
+static void StartGame(GAME_MODE_t mode) {
+    gGameMode = mode;
+    gLastLevelFinalPlatformY = -1; // Reset para início de nova partida
+    if (mode == GAME_MODE_ENDLESS) {
+        InitEndlessElements();
+        SetState(GAME_STATE_PLAY);
+    } else {
+        RequestLevel();
+    }
+}
+
+// Desenha um retângulo em coordenadas de mundo, recortado à janela da câmera
+static void DrawWorldRect(D1306_t* display, int camera_x, int x, int y, int width, int height) {
+    int left = x - camera_x;
+    int right = left + width;
+    if (left < 0) left = 0;
+    if (right > SCREEN_WIDTH) right = SCREEN_WIDTH;
+    if (right <= left || y >= SCREEN_HEIGHT || y + height <= 0) return;
+    if (y < 0) { height += y; y = 0; }
+    D1306_DrawSquare(display, left, y, right - left, height);
+}
+
+// Posição entre o tick anterior e o atual; frac em 1/256 de tick
+static int Interpolate(int from, int to, int frac) {
+    int delta = to - from;
+    if (delta > INTERP_MAX_JUMP || delta < -INTERP_MAX_JUMP) return to;
+    return from + delta * frac / 256;
+}
+
+// Ignora os botões por STATE_TRANSITION_DEBOUNCE_MS após uma troca de tela
+static void BlockInput(uint64_t now_us) {
+    input_blocked_until_us = now_us + (uint64_t)STATE_TRANSITION_DEBOUNCE_MS * 1000;
+}
+
+/****************************
+* API
+****************************/
+
+// Volta todo o estado do jogo ao de uma placa recém-ligada; seed define todos os níveis
+// Chamada antes do escalonador (ou com as tarefas do jogo paradas)
+void GAME_Init(uint32_t seed) {
+#if CHAOS_RTOS
+#if configSUPPORT_STATIC_ALLOCATION
+    if (!gGameLock) gGameLock = xSemaphoreCreateMutexStatic(&gGameLockBuffer);
+#else
+    if (!gGameLock) gGameLock = xSemaphoreCreateMutex();
+#endif
+    configASSERT(gGameLock);
+#endif
+    gLevelRandom = RANDOM_Seed(seed);
+    gCurrentGameState = GAME_STATE_MENU;
+    gGameMode = GAME_MODE_LEVELS;
+    gPlayerSpeed = PLAYER_SPEED_DEFAULT;
+    gLastLevelFinalPlatformY = -1;
+    gLevelPending = false;
+
+    b_press_start_time_us = 0; b_long_pressed_triggered = false; b_click_start_time_us = 0;
+    a_press_start_time_us = 0; input_blocked_until_us = 0;
+    lastStateButtonA = false; lastStateButtonB = false;
+
+    InitGameElements();
+}
+
+// Guarda o nível atual no estado em que começa (chamar antes do primeiro tick de PLAY)
+void GAME_SaveLevel(GAME_LEVEL_t* level) {
+    memcpy(&level->platforms, &gPlatforms, sizeof(level->platforms));
+    memcpy(&level->terrain, &gTerrain, sizeof(level->terrain));
+    level->goal_x = gGoalX; level->goal_y = gGoalY; level->world_width = gWorldWidth;
+    level->player_x = gPlayerPos[0]; level->player_y = gPlayerPos[1];
+}
+
+// Entra em PLAY no modo níveis com um nível guardado, como se acabasse de ser sorteado
+void GAME_PlayLevel(const GAME_LEVEL_t* level, uint64_t now_us) {
+    gGameMode = GAME_MODE_LEVELS;
+    LoadLevel(level);
+    SetState(GAME_STATE_PLAY);
+    a_press_start_time_us = 0; b_press_start_time_us = 0; b_click_start_time_us = 0;
+    lastStateButtonA = false; lastStateButtonB = false;
+    BlockInput(now_us);
+}
+
+// Um tick de física do personagem contra o terreno e as plataformas dadas (as do jogo ou uma cópia do solver).
+// i é o apoio sob o personagem, como devolvido por PLATFORMS_FindSupport.
+GAME_PLAYER_STEP_t GAME_StepPlayer(const PLATFORMS_t* platforms, const TILEMAP_t* terrain, int goal_x, int i, int* px, int* py) {
+    GAME_PLAYER_STEP_t step = GAME_PLAYER_FALLING;
+    if (i != PLATFORM_NONE) {
+        *py = platforms->y[i] - platforms->height[i]; step = GAME_PLAYER_SUPPORTED;
+        *py += PLATFORMS_NextStep(platforms, i); // Acompanha o passo que a plataforma dá no próximo tick
+    } else if (TerrainUnder(terrain, *px, *py + PLAYER_HEIGHT)) {
+        // Sobe até a superfície se os pés entraram na faixa do topo; mais fundo que isso, atravessa
+        int lift = 0;
+        while (lift < STATIC_PLATFORM_HEIGHT && TerrainUnder(terrain, *px, *py + PLAYER_HEIGHT - 1 - lift)) lift++;
+        if (!TerrainUnder(terrain, *px, *py + PLAYER_HEIGHT - 1 - lift)) {
+            *py -= lift; step = GAME_PLAYER_SUPPORTED;
+            // Detecção de nível completo: Chegou na plataforma final
+            if (goal_x >= 0 && *px + PLAYER_WIDTH > goal_x) step = GAME_PLAYER_GOAL;
+        }
+    }
+    if (step == GAME_PLAYER_FALLING) {
+        *py += PLAYER_GRAVITY;
+        if (*py >= SCREEN_HEIGHT - PLAYER_HEIGHT) step = GAME_PLAYER_DEAD;
+    }
+    return step;
+}
+
+// Deslocamento horizontal de uma amostra dos botões, com os limites do modo atual
+int GAME_PlayerInputX(int x, bool a, bool b) {
+    if (gGameMode == GAME_MODE_LEVELS) return GAME_LevelInputX(x, a, b, gPlayerSpeed, gWorldWidth);
+    if (a) { x -= gPlayerSpeed; if (x < gCameraX) x = gCameraX; }
+    if (b) x += gPlayerSpeed;
+    return x;
+}
+
+// O mesmo no modo níveis, com velocidade e largura do mundo dadas (o solver monta níveis fora da trava)
+int GAME_LevelInputX(int x, bool a, bool b, int speed, int world_width) {
+    if (a) { x -= speed; if (x < 0) x = 0; }
+    if (b) { x += speed; if (x >= world_width - PLAYER_WIDTH) x = world_width - PLAYER_WIDTH - 1; }
+    return x;
+}
+
+static void Input(bool currentStateA, bool currentStateB, uint64_t now_us) {
+    // Nível em montagem: a tela ainda não mudou, e o debounce conta a partir da última amostra
+    if (gLevelPending) BlockInput(now_us);
+    if (now_us < input_blocked_until_us) {
+        lastStateButtonA = currentStateA; lastStateButtonB = currentStateB;
+        return;
+    }
+
+    if (gCurrentGameState == GAME_STATE_MENU) {
+        // Clique em A: níveis; segurar A: modo infinito
+        if (currentStateA && !lastStateButtonA) {
+            a_press_start_time_us = now_us;
+        } else if (a_press_start_time_us != 0 &&
+                   (!currentStateA || now_us - a_press_start_time_us >= (uint64_t)LONG_PRESS_TIME_MS * 1000)) {
+            StartGame(currentStateA ? GAME_MODE_ENDLESS : GAME_MODE_LEVELS);
+            a_press_start_time_us = 0;
+            BlockInput(now_us);
+        } else if (currentStateB && !lastStateButtonB && a_press_start_time_us == 0) {
+            SetState(GAME_STATE_CONFIG);
+            BlockInput(now_us);
+            b_press_start_time_us = 0; b_long_pressed_triggered = false; b_click_start_time_us = 0;
+        }
+    } else if (gCurrentGameState == GAME_STATE_PLAY) {
+        gPlayerPos[0] = GAME_PlayerInputX(gPlayerPos[0], currentStateA, currentStateB);
+    } else if (gCurrentGameState == GAME_STATE_CONFIG) {
+        if (currentStateA && !lastStateButtonA) { if (gPlayerSpeed < PLAYER_SPEED_MAX) gPlayerSpeed++; }
+        if (currentStateB && !lastStateButtonB) {
+            b_press_start_time_us = now_us; b_click_start_time_us = now_us; b_long_pressed_triggered = false;
+        } else if (currentStateB && lastStateButtonB) {
+            if (!b_long_pressed_triggered) {
+                uint64_t elapsed_time_us = now_us - b_press_start_time_us;
+                if (elapsed_time_us >= (uint64_t)LONG_PRESS_TIME_MS * 1000) {
+                    SetState(GAME_STATE_MENU); b_long_pressed_triggered = true; b_press_start_time_us = 0;
+                    BlockInput(now_us);
+                }
+            }
+        } else if (!currentStateB && lastStateButtonB) {
+            uint64_t click_duration_us = now_us - b_click_start_time_us;
+            if (!b_long_pressed_triggered && click_duration_us < (uint64_t)SHORT_CLICK_MAX_TIME_MS * 1000 && b_click_start_time_us != 0) {
+                if (gPlayerSpeed > PLAYER_SPEED_MIN) gPlayerSpeed--;
+            }
+            b_press_start_time_us = 0; b_long_pressed_triggered = false; b_click_start_time_us = 0;
+        }
+    } else if (gCurrentGameState == GAME_STATE_GAME_OVER) {
+        if ((currentStateA && !lastStateButtonA) || (currentStateB && !lastStateButtonB)) {
+            SetState(GAME_STATE_MENU);
+            gLastLevelFinalPlatformY = -1; // Reset para início de nova partida
+            BlockInput(now_us);
+        }
+    } else if (gCurrentGameState == GAME_STATE_LEVEL_COMPLETE) {
+        if ((currentStateA && !lastStateButtonA) || (currentStateB && !lastStateButtonB)) {
+            gLastLevelFinalPlatformY = gGoalY; // Salva a altura da plataforma final
+            RequestLevel(); // Próximo nível: PLAY só começa com ele montado e resolvido
+            BlockInput(now_us);
+        }
+    }
+    lastStateButtonA = currentStateA; lastStateButtonB = currentStateB;
+}
+
+void GAME_Input(bool currentStateA, bool currentStateB, uint64_t now_us) {
+    GAME_LOCK();
+    Input(currentStateA, currentStateB, now_us);
+    GAME_UNLOCK();
+}
+
+// Chamada antes do escalonador, como GAME_Init
+void GAME_SetStateHook(GAME_STATE_HOOK_t hook) {
+    gStateHook = hook;
+}
+
+// Chamada antes do escalonador, como GAME_Init
+void GAME_SetLevelHook(GAME_LEVEL_HOOK_t hook) {
+    gLevelHook = hook;
+}
+
+// O sorteio e o solver levam vários ms: fora da trava, Display e ButtonControl seguem rodando.
+// Nada mais mexe no pedido nem em gNextLevel enquanto ele está pendente.
+void GAME_BuildLevel(void) {
+    GAME_LOCK();
+    bool pending = gLevelPending;
+    uint32_t random = gPendingRandom;
+    int start_y = gPendingStartY, speed = gPendingSpeed;
+    GAME_UNLOCK();
+    if (!pending) return;
+
+    GenerateLevel(&gNextLevel, &random, start_y, speed);
+
+    GAME_LOCK();
+    gPendingRandom = random;
+    EnterPendingLevel();
+    GAME_UNLOCK();
+}
+
+// now_us: instante do tick, usado pela interpolação de GAME_Render
+void GAME_StepPlatforms(uint64_t now_us) {
+    GAME_LOCK();
+    if (gCurrentGameState == GAME_STATE_PLAY) {
+        gInterpPlayer[0] = gPlayerPos[0]; gInterpPlayer[1] = gPlayerPos[1];
+        gInterpCameraX = gCameraX;
+        memcpy(gInterpPlatformY, gPlatforms.y, gPlatforms.count * sizeof(gPlatforms.y[0]));
+        gInterpTickUs = now_us;
+        gInterpValid = true;
+
+        PLATFORMS_Move(&gPlatforms, &gPlatformBounds);
+    }
+    GAME_UNLOCK();
+}
+
+static void StepLogic(void) {
+    if (gCurrentGameState != GAME_STATE_PLAY) return;
+
+    int support = PLATFORMS_FindSupport(&gPlatforms, gPlayerPos[0], gPlayerPos[1], PLAYER_WIDTH, PLAYER_HEIGHT, PLAYER_GRAVITY);
+    GAME_TRACE_SUPPORT(support);
+    GAME_PLAYER_STEP_t step = GAME_StepPlayer(&gPlatforms, &gTerrain, gGoalX, support, &gPlayerPos[0], &gPlayerPos[1]);
+    if (step == GAME_PLAYER_GOAL) {
+        GAME_LOG("NIVEL COMPLETO!\n");
+        SetState(GAME_STATE_LEVEL_COMPLETE);
+    }
+    UpdateCamera();
+    if (gGameMode == GAME_MODE_ENDLESS) StepEndlessGeneration();
+    if (step == GAME_PLAYER_DEAD) {
+        GAME_LOG("!!! GAME OVER !!!\n");
+        SetState(GAME_STATE_GAME_OVER);
+    }
+}
+
+void GAME_StepLogic(void) {
+    GAME_LOCK();
+    StepLogic();
+    GAME_UNLOCK();
+}
+
+// Só compõe o quadro no buffer; o envio (D1306_Show) fica fora da trava
+static void Render(D1306_t* display, uint64_t now_us) {
+    char str_buffer[20];
+
+    D1306_Clear(display);
+
+    if (gCurrentGameState == GAME_STATE_MENU) {
+        // Montanhas usam rand(): só enfeite, não consome os sorteios dos níveis
+        int mountain_base_y = 40; int peak_height = 20;
+        for (int x = 0; x < SCREEN_WIDTH / 2; x += 3) {
+            int y_offset = rand() % (peak_height / 2) - (peak_height / 4);
+            int current_height = (int)((float)peak_height * (1.0f - (float)x / (SCREEN_WIDTH / 2))) + y_offset;
+            if (current_height < 1) current_height = 1;
+            D1306_DrawSquare(display, x, mountain_base_y - current_height, 2, current_height);
+            if (rand() % 10 < 3) D1306_DrawPixel(display, x + rand()%2, mountain_base_y - current_height - (rand()%5 + 1));
+        }
+        for (int x = SCREEN_WIDTH / 2; x < SCREEN_WIDTH; x += 3) {
+            int y_offset = rand() % (peak_height / 2) - (peak_height / 4);
+            int current_height = (int)((float)peak_height * ((float)(x - SCREEN_WIDTH / 2) / (SCREEN_WIDTH / 2))) + y_offset;
+            if (current_height < 1) current_height = 1;
+            D1306_DrawSquare(display, x, mountain_base_y - current_height, 2, current_height);
+            if (rand() % 10 < 3) D1306_DrawPixel(display, x + rand()%2, mountain_base_y - current_height - (rand()%5 + 1));
+        }
+
+        int char_width = 5; const char* title_chaos = "CHAOS"; const char* title_climb = "CLIMB";
+        D1306_DrawString(display, (SCREEN_WIDTH - (strlen(title_chaos) * char_width)) / 2, 8, 1, title_chaos);
+        D1306_DrawString(display, (SCREEN_WIDTH - (strlen(title_climb) * char_width)) / 2, 16, 1, title_climb);
+        D1306_DrawString(display, (SCREEN_WIDTH - (strlen("A: INICIAR") * char_width)) / 2, 42, 1, "A: INICIAR");
+        D1306_DrawString(display, (SCREEN_WIDTH - (strlen("SEGURE A: INFINITO") * char_width)) / 2, 50, 1, "SEGURE A: INFINITO");
+        D1306_DrawString(display, (SCREEN_WIDTH - (strlen("B: CONFIG") * char_width)) / 2, 58, 1, "B: CONFIG");
+
+    } else if (gCurrentGameState == GAME_STATE_PLAY) {
+        // Desenha entre o tick anterior e o atual: o display (30 ms) não anda no passo da lógica (10 ms)
+        int frac = 256;
+        if (gInterpValid && now_us < gInterpTickUs + GAME_LOGIC_PERIOD_MS * 1000) {
+            frac = now_us > gInterpTickUs ? (int)((now_us - gInterpTickUs) * 256 / (GAME_LOGIC_PERIOD_MS * 1000)) : 0;
+        }
+        bool interpolate = gInterpValid && frac < 256;
+
+        // Terreno: tiles alinhados às páginas, copiados direto para o buffer
+        int camera_x = interpolate ? Interpolate(gInterpCameraX, gCameraX, frac) : gCameraX;
+        TILEMAP_Render(&gTerrain, display, camera_x);
+
+        // Só as plataformas nos baldes sob a janela da câmera são desenhadas
+        uint32_t visible[PLATFORM_FLAG_WORDS];
+        PLATFORMS_QuerySpan(&gPlatforms, camera_x, camera_x + SCREEN_WIDTH, visible);
+
+        int player_x = interpolate ? Interpolate(gInterpPlayer[0], gPlayerPos[0], frac) : gPlayerPos[0];
+        int player_y = interpolate ? Interpolate(gInterpPlayer[1], gPlayerPos[1], frac) : gPlayerPos[1];
+        DrawWorldRect(display, camera_x, player_x, player_y, PLAYER_WIDTH, PLAYER_HEIGHT);
+        for (int i; (i = PLATFORMS_PopMask(visible)) != PLATFORM_NONE; ) {
+            int y = interpolate ? Interpolate(gInterpPlatformY[i], gPlatforms.y[i], frac) : gPlatforms.y[i];
+            DrawWorldRect(display, camera_x, gPlatforms.x[i], y, gPlatforms.width[i], gPlatforms.height[i]);
+        }
+    } else if (gCurrentGameState == GAME_STATE_CONFIG) {
+        int char_width = 5;
+        D1306_DrawString(display, (SCREEN_WIDTH - (strlen("CONFIG") * char_width)) / 2, 10, 1, "CONFIG");
+        sprintf(str_buffer, "VELOC: %d", gPlayerSpeed);
+        D1306_DrawString(display, 10, 30, 1, str_buffer);
+        D1306_DrawString(display, 10, 40, 1, "A: + B: -");
+        D1306_DrawString(display, 10, 50, 1, "SEGURE B P/ SAIR");
+
+        if (b_press_start_time_us != 0 && !b_long_pressed_triggered) {
+            uint64_t elapsed_time_us = now_us - b_press_start_time_us;
+            int progress_width = (int)((float)elapsed_time_us / (LONG_PRESS_TIME_MS * 1000.0f) * SCREEN_WIDTH);
+            if (progress_width > SCREEN_WIDTH) progress_width = SCREEN_WIDTH;
+            D1306_DrawSquare(display, 0, 60, progress_width, 2);
+        }
+    } else if (gCurrentGameState == GAME_STATE_GAME_OVER) {
+        int gameover_char_width = 5; int gameover_scale = 2;
+        const char* game_over_text = "GAME OVER";
+        int actual_text_width_pixels = strlen(game_over_text) * gameover_char_width * gameover_scale;
+        int actual_text_height_pixels = 8 * gameover_scale;
+        D1306_DrawString(display, (SCREEN_WIDTH - actual_text_width_pixels) / 2,
+                         (SCREEN_HEIGHT - actual_text_height_pixels) / 2, gameover_scale, game_over_text);
+    } else if (gCurrentGameState == GAME_STATE_LEVEL_COMPLETE) {
+        int char_width = 5; int scale = 2;
+        const char* msg1 = "NIVEL";
+        const char* msg2 = "COMPLETO!";
+        int actual_text_width_pixels1 = strlen(msg1) * char_width * scale;
+        int actual_text_width_pixels2 = strlen(msg2) * char_width * scale;
+        int actual_text_height_pixels = 8 * scale; // Altura de uma linha de texto na escala 2
+
+        // Centraliza "NIVEL COMPLETO!" em duas linhas
+        D1306_DrawString(display, (SCREEN_WIDTH - actual_text_width_pixels1) / 2,
+                         (SCREEN_HEIGHT / 2) - actual_text_height_pixels + 5, scale, msg1); // Ajuste Y
+        D1306_DrawString(display, (SCREEN_WIDTH - actual_text_width_pixels2) / 2,
+                         (SCREEN_HEIGHT / 2) + 5, scale, msg2); // Ajuste Y
+    }
+}
+
+void GAME_Render(D1306_t* display, uint64_t now_us) {
+    GAME_LOCK();
+    Render(display, now_us);
+    GAME_UNLOCK();
+}
+
+// O menu anima: as montanhas são sorteadas de novo a cada quadro
+bool GAME_IsAnimated(void) {
+    GAME_LOCK();
+    bool animated = gCurrentGameState == GAME_STATE_PLAY || gCurrentGameState == GAME_STATE_MENU ||
+                    (gCurrentGameState == GAME_STATE_CONFIG && b_press_start_time_us != 0 && !b_long_pressed_triggered);
+    GAME_UNLOCK();
+    return animated;
+}
@@ -1,10 +1,24 @@
 #include "gpio.h"
+#include "alloc.h"
+
+#if CHAOS_STATIC_ALLOC
+static GPIO_t gpio_pool[GPIO_MAX_HANDLES];
+static size_t gpio_pool_used;
+#endif
+
+static GPIO_CALLBACK_t gpio_irq_callback;
+
+static void GPIO_IrqHandler( uint pin , uint32_t events )
+{
+    (void)pin; (void)events;
+    if( gpio_irq_callback ) gpio_irq_callback();
+}
 
 GPIO_t* GPIO_Init( GPIO_CONFIG_t cfg )
 {
     GPIO_t* gpio;
 
-    gpio = (GPIO_t*)malloc( sizeof ( GPIO_t ) );
+    gpio = HAL_ALLOC( GPIO_t , gpio_pool , gpio_pool_used , HAL_ALLOC_GPIO );
     
     assert( gpio != NULL );
     
@@ -53,4 +67,10 @@ bool GPIO_GetInput( GPIO_t* gpio )
     {
         return !gpio_get( gpio->pin );
     }
-}
\ No newline at end of file
+}
+
+void GPIO_SetIrq( GPIO_t* gpio , bool enabled , GPIO_CALLBACK_t callback )
+{
+    gpio_irq_callback = callback;
+    gpio_set_irq_enabled_with_callback( gpio->pin , GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE , enabled , GPIO_IrqHandler );
+}
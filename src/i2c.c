@@ -1,10 +1,23 @@
 #include "i2c.h"
+#include "alloc.h"
+
+#if CHAOS_TRACE
+#include "trace.h"
+#define I2C_TRACE( type , arg ) TRACE_Record( type , arg )
+#else
+#define I2C_TRACE( type , arg )
+#endif
+
+#if CHAOS_STATIC_ALLOC
+static I2C_t i2c_pool[I2C_MAX_HANDLES];
+static size_t i2c_pool_used;
+#endif
 
 I2C_t* I2C_Init( I2C_CONFIG_t cfg )
 {
     I2C_t* i2c;
 
-    i2c = (I2C_t*)malloc( sizeof ( I2C_t ) );
+    i2c = HAL_ALLOC( I2C_t , i2c_pool , i2c_pool_used , HAL_ALLOC_I2C );
     
     assert( i2c != NULL );
 
@@ -37,13 +50,17 @@ size_t I2C_ReadByte( I2C_t* i2c , char* buffer )
 size_t I2C_WriteByteArray( I2C_t* i2c , char* buffer , size_t length )
 {
     size_t success;
+    I2C_TRACE( TRACE_I2C_START , length );
     success = i2c_write_blocking( i2c->i2c_hw , i2c->address , buffer , length , true );
+    I2C_TRACE( TRACE_I2C_END , 0 );
     if( success == length ) { return true; } else { return false; }
 }
 
 size_t I2C_ReadByteArray( I2C_t* i2c , char* buffer , size_t length)
 {
     size_t success;
+    I2C_TRACE( TRACE_I2C_START , length );
     success = i2c_read_blocking( i2c->i2c_hw , i2c->address , buffer , length , false );
+    I2C_TRACE( TRACE_I2C_END , 0 );
     if( success == length ) { return true; } else { return false; }
 }
\ No newline at end of file
@@ -1,10 +1,16 @@
 #include <include/joystick.h>
+#include <include/alloc.h>
+
+#if CHAOS_STATIC_ALLOC
+static JOYSTICK_t joystick_pool[JOYSTICK_MAX_HANDLES];
+static size_t joystick_pool_used;
+#endif
 
 JOYSTICK_t* JOYSTICK_Init( JOYSTICK_CONFIG_t cfg )
 {
     JOYSTICK_t* joystick;
 
-    joystick = (JOYSTICK_t*)malloc( sizeof ( JOYSTICK_t ) );
+    joystick = HAL_ALLOC( JOYSTICK_t , joystick_pool , joystick_pool_used , HAL_ALLOC_JOYSTICK );
     
     assert( joystick != NULL );
 
@@ -0,0 +1,317 @@
+#include "platform.h"
+#include "random.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+// Meia volta de cosseno, (1 - cos(pi * k / PLATFORM_EASE_STEPS)) / 2, em 0..255
+static const uint8_t platform_ease[PLATFORM_EASE_STEPS + 1] = {
+      0,   0,   1,   1,   2,   4,   5,   7,  10,  12,  15,  18,  21,  25,  29,  33,
+     37,  42,  47,  52,  57,  62,  67,  73,  79,  85,  90,  97, 103, 109, 115, 121,
+    127, 134, 140, 146, 152, 158, 165, 170, 176, 182, 188, 193, 198, 203, 208, 213,
+    218, 222, 226, 230, 234, 237, 240, 243, 245, 248, 250, 251, 253, 254, 254, 255,
+    255
+};
+
+static inline int PLATFORMS_Column( int x )
+{
+    return x >> PLATFORM_BUCKET_SHIFT;
+}
+
+// Palavras das máscaras que podem ter bits: índices >= count nunca são marcados
+static inline int PLATFORMS_ActiveWords( const PLATFORMS_t* platforms )
+{
+    return ( platforms->count + 31 ) >> 5;
+}
+
+static inline uint32_t PLATFORMS_EaseHalf( const PLATFORMS_t* platforms , int i )
+{
+    return (uint32_t)platforms->travel[i] * platforms->speed_interval[i];
+}
+
+// Distância (0..travel) do topo do caminho suavizado na posição u da volta
+static int PLATFORMS_EaseOffset( const PLATFORMS_t* platforms , int i , uint32_t u )
+{
+    uint32_t half = PLATFORMS_EaseHalf( platforms , i );
+    if( u > half ) u = 2 * half - u;
+
+    uint32_t k = ( u * PLATFORM_EASE_STEPS + half / 2 ) / half;
+    return ( platforms->travel[i] * platform_ease[k] + 127 ) / 255;
+}
+
+// Ticks desde o último passo de uma travessia: o que falta até o slot dela, descontado do período
+static inline uint32_t PLATFORMS_CrossElapsed( const PLATFORMS_t* platforms , int i )
+{
+    return platforms->speed_interval[i] - (uint8_t)( platforms->phase[i] - platforms->wheel_tick );
+}
+
+static inline bool PLATFORMS_InWheel( const PLATFORMS_t* platforms , int i )
+{
+    return PLATFORMS_IsMoving( platforms , i ) && !( ( platforms->eased[i >> 5] >> ( i & 31 ) ) & 1 );
+}
+
+// Põe a travessia i no slot do tick due; a ordem dentro do slot não importa
+static void PLATFORMS_Schedule( PLATFORMS_t* platforms , int i , uint8_t due )
+{
+    platforms->phase[i] = due;
+    platforms->wheel_next[i] = platforms->wheel[due];
+    platforms->wheel[due] = i;
+}
+
+static void PLATFORMS_Unschedule( PLATFORMS_t* platforms , int i )
+{
+    int16_t* link = &platforms->wheel[(uint8_t)platforms->phase[i]];
+
+    while( *link != i )
+    {
+        assert( *link != PLATFORM_NONE );
+        link = &platforms->wheel_next[*link];
+    }
+    *link = platforms->wheel_next[i];
+}
+
+// Marca (ou desmarca) a plataforma i em todos os baldes cobertos pelo seu vão em x
+static void PLATFORMS_IndexSpan( PLATFORMS_t* platforms , int i , bool insert )
+{
+    int first = PLATFORMS_Column( platforms->x[i] );
+    int last = PLATFORMS_Column( platforms->x[i] + platforms->width[i] - 1 );
+    uint32_t mask = 1u << ( i & 31 );
+
+    if( last - first >= PLATFORM_BUCKET_COUNT ) last = first + PLATFORM_BUCKET_COUNT - 1;
+
+    for( int b = first ; b <= last ; ++b )
+    {
+        uint32_t* word = &platforms->buckets[b & ( PLATFORM_BUCKET_COUNT - 1 )][i >> 5];
+        if( insert ) { *word |= mask; } else { *word &= ~mask; }
+    }
+}
+
+void PLATFORMS_Clear( PLATFORMS_t* platforms )
+{
+    memset( platforms->moving , 0 , sizeof( platforms->moving ) );
+    memset( platforms->down , 0 , sizeof( platforms->down ) );
+    memset( platforms->eased , 0 , sizeof( platforms->eased ) );
+    memset( platforms->buckets , 0 , sizeof( platforms->buckets ) );
+    for( int slot = 0 ; slot < PLATFORM_WHEEL_SLOTS ; ++slot ) platforms->wheel[slot] = PLATFORM_NONE;
+    platforms->wheel_tick = 0;
+    platforms->count = 0;
+}
+
+int PLATFORMS_Add( PLATFORMS_t* platforms , PLATFORM_CONFIG_t cfg )
+{
+    if( platforms->count >= PLATFORM_MAX_COUNT ) return PLATFORM_NONE;
+
+    int i = platforms->count;
+    PLATFORMS_Set( platforms , i , cfg );
+
+    return i;
+}
+
+void PLATFORMS_Set( PLATFORMS_t* platforms , int i , PLATFORM_CONFIG_t cfg )
+{
+    assert( i >= 0 && i < PLATFORM_MAX_COUNT );
+
+    uint32_t mask = 1u << ( i & 31 );
+
+    // Reaproveitando um slot ainda vivo: sai da roda antes de mudar o período
+    if( i < platforms->count && PLATFORMS_InWheel( platforms , i ) ) PLATFORMS_Unschedule( platforms , i );
+    // ... e dos baldes do vão antigo (desmarcar um slot removido não muda nada)
+    if( i < platforms->count ) PLATFORMS_IndexSpan( platforms , i , false );
+
+    platforms->x[i] = cfg.x;
+    platforms->y[i] = cfg.y;
+    platforms->width[i] = cfg.width;
+    platforms->height[i] = cfg.height;
+    platforms->speed_interval[i] = cfg.speed_interval;
+    platforms->travel[i] = cfg.travel;
+    platforms->jitter[i] = cfg.is_moving ? RANDOM_Below( &platforms->random , PLATFORM_RESET_JITTER ) : 0;
+    // Caminho suavizado subindo: começa no fundo da volta, com o topo travel px acima
+    platforms->phase[i] = ( cfg.travel && cfg.direction == DIR_UP ) ? PLATFORMS_EaseHalf( platforms , i ) : 0;
+
+    assert( cfg.speed_interval > 0 && PLATFORMS_EaseHalf( platforms , i ) < 32768 );
+
+    if( cfg.is_moving ) { platforms->moving[i >> 5] |= mask; } else { platforms->moving[i >> 5] &= ~mask; }
+    if( cfg.direction == DIR_DOWN ) { platforms->down[i >> 5] |= mask; } else { platforms->down[i >> 5] &= ~mask; }
+    if( cfg.is_moving && cfg.travel ) { platforms->eased[i >> 5] |= mask; } else { platforms->eased[i >> 5] &= ~mask; }
+
+    // Travessia recém-criada: primeiro passo daqui a speed_interval ticks
+    if( cfg.is_moving && !cfg.travel ) PLATFORMS_Schedule( platforms , i , platforms->wheel_tick + cfg.speed_interval );
+
+    PLATFORMS_IndexSpan( platforms , i , true );
+
+    if( i >= platforms->count ) platforms->count = i + 1;
+}
+
+// Tira a plataforma do índice e do movimento; o slot pode ser reaproveitado por PLATFORMS_Set
+void PLATFORMS_Remove( PLATFORMS_t* platforms , int i )
+{
+    if( i >= platforms->count ) return;
+
+    if( PLATFORMS_InWheel( platforms , i ) ) PLATFORMS_Unschedule( platforms , i );
+
+    PLATFORMS_IndexSpan( platforms , i , false );
+    platforms->moving[i >> 5] &= ~( 1u << ( i & 31 ) );
+    platforms->eased[i >> 5] &= ~( 1u << ( i & 31 ) );
+}
+
+// Desloca todo o mundo em x; dx múltiplo de PLATFORM_BUCKET_SPAN mantém os baldes intactos
+void PLATFORMS_ShiftX( PLATFORMS_t* platforms , int16_t dx )
+{
+    assert( ( dx % PLATFORM_BUCKET_SPAN ) == 0 );
+
+    for( int i = 0 ; i < platforms->count ; ++i ) platforms->x[i] -= dx;
+}
+
+// Move uma plataforma viva em x; use PLATFORMS_Set para reaproveitar um slot removido
+void PLATFORMS_SetX( PLATFORMS_t* platforms , int i , int16_t x )
+{
+    int width = platforms->width[i];
+
+    // Sem troca de balde, basta atualizar a coordenada
+    if( PLATFORMS_Column( x ) == PLATFORMS_Column( platforms->x[i] ) &&
+        PLATFORMS_Column( x + width - 1 ) == PLATFORMS_Column( platforms->x[i] + width - 1 ) )
+    {
+        platforms->x[i] = x;
+        return;
+    }
+
+    PLATFORMS_IndexSpan( platforms , i , false );
+    platforms->x[i] = x;
+    PLATFORMS_IndexSpan( platforms , i , true );
+}
+
+void PLATFORMS_Move( PLATFORMS_t* platforms , const PLATFORM_BOUNDS_t* bounds )
+{
+    // Suavizadas avançam todo tick: percorre só os bits delas
+    for( int word = 0 ; word < PLATFORM_FLAG_WORDS ; ++word )
+    {
+        for( uint32_t pending = platforms->eased[word] ; pending ; pending &= pending - 1 )
+        {
+            int i = ( word << 5 ) + __builtin_ctz( pending );
+            uint32_t u = platforms->phase[i] + 1;
+            if( u == 2 * PLATFORMS_EaseHalf( platforms , i ) ) u = 0;
+            platforms->y[i] += PLATFORMS_EaseOffset( platforms , i , u ) - PLATFORMS_EaseOffset( platforms , i , platforms->phase[i] );
+            platforms->phase[i] = u;
+        }
+    }
+
+    // Travessias: só as do slot deste tick; as demais nem são visitadas
+    uint8_t tick = ++platforms->wheel_tick;
+    int i = platforms->wheel[tick];
+    platforms->wheel[tick] = PLATFORM_NONE;
+
+    while( i != PLATFORM_NONE )
+    {
+        int next = platforms->wheel_next[i];
+
+        if( PLATFORMS_GetDirection( platforms , i ) == DIR_DOWN )
+        {
+            platforms->y[i]++;
+            if( platforms->y[i] > bounds->bottom )
+            {
+                platforms->y[i] = bounds->top - platforms->height[i] - bounds->reset_offset - platforms->jitter[i];
+            }
+        }else
+        {
+            platforms->y[i]--;
+            if( platforms->y[i] + platforms->height[i] < bounds->top )
+            {
+                platforms->y[i] = bounds->bottom + bounds->reset_offset + platforms->jitter[i];
+            }
+        }
+
+        PLATFORMS_Schedule( platforms , i , tick + platforms->speed_interval[i] );
+        i = next;
+    }
+}
+
+// Altura da plataforma i daqui a ahead ticks, igual à de ahead chamadas de PLATFORMS_Move.
+// Atravessando a tela, a plataforma percorre um ciclo fixo de alturas: de onde reaparece até
+// a borda por onde sai.
+int16_t PLATFORMS_YAt( const PLATFORMS_t* platforms , const PLATFORM_BOUNDS_t* bounds , int i , uint32_t ahead )
+{
+    int y = platforms->y[i];
+
+    if( !PLATFORMS_IsMoving( platforms , i ) ) return y;
+
+    if( platforms->travel[i] )
+    {
+        uint32_t u = ( platforms->phase[i] + ahead ) % ( 2 * PLATFORMS_EaseHalf( platforms , i ) );
+        return y - PLATFORMS_EaseOffset( platforms , i , platforms->phase[i] ) + PLATFORMS_EaseOffset( platforms , i , u );
+    }
+
+    uint32_t steps = ( PLATFORMS_CrossElapsed( platforms , i ) + ahead ) / platforms->speed_interval[i];
+
+    if( PLATFORMS_GetDirection( platforms , i ) == DIR_DOWN )
+    {
+        int low = bounds->top - platforms->height[i] - bounds->reset_offset - platforms->jitter[i];
+        uint32_t cycle = bounds->bottom - low + 1;
+        assert( y >= low && y <= bounds->bottom );
+        return low + ( y - low + steps % cycle ) % cycle;
+    }
+
+    int high = bounds->bottom + bounds->reset_offset + platforms->jitter[i];
+    uint32_t cycle = high - ( bounds->top - platforms->height[i] ) + 1;
+    assert( y <= high && y >= bounds->top - platforms->height[i] );
+    return high - ( high - y + steps % cycle ) % cycle;
+}
+
+// Quanto a plataforma i anda no próximo tick (sem contar o salto de quem dá a volta na tela)
+int PLATFORMS_NextStep( const PLATFORMS_t* platforms , int i )
+{
+    if( !PLATFORMS_IsMoving( platforms , i ) ) return 0;
+
+    if( platforms->travel[i] )
+    {
+        uint32_t u = platforms->phase[i] + 1;
+        if( u == 2 * PLATFORMS_EaseHalf( platforms , i ) ) u = 0;
+        return PLATFORMS_EaseOffset( platforms , i , u ) - PLATFORMS_EaseOffset( platforms , i , platforms->phase[i] );
+    }
+
+    if( PLATFORMS_CrossElapsed( platforms , i ) + 1 != platforms->speed_interval[i] ) return 0;
+    return PLATFORMS_GetDirection( platforms , i ) == DIR_DOWN ? 1 : -1;
+}
+
+void PLATFORMS_QuerySpan( const PLATFORMS_t* platforms , int16_t x0 , int16_t x1 , uint32_t* out )
+{
+    int first = PLATFORMS_Column( x0 );
+    int last = PLATFORMS_Column( x1 - 1 );
+    int words = PLATFORMS_ActiveWords( platforms );
+
+    memset( out , 0 , PLATFORM_FLAG_WORDS * sizeof( uint32_t ) );
+
+    // Só os baldes sob o vão [x0, x1) contribuem candidatos
+    for( int b = first ; b <= last && b - first < PLATFORM_BUCKET_COUNT ; ++b )
+    {
+        const uint32_t* bucket = platforms->buckets[b & ( PLATFORM_BUCKET_COUNT - 1 )];
+        for( int word = 0 ; word < words ; ++word ) out[word] |= bucket[word];
+    }
+}
+
+int PLATFORMS_FindSupport( const PLATFORMS_t* platforms , int16_t px , int16_t py , int16_t pw , int16_t ph , int16_t gravity )
+{
+    uint32_t candidates[PLATFORM_FLAG_WORDS];
+    int16_t feet = py + ph;
+    int best = PLATFORM_NONE;
+    int words = PLATFORMS_ActiveWords( platforms );
+
+    PLATFORMS_QuerySpan( platforms , px , px + pw , candidates );
+
+    for( int word = 0 ; word < words ; ++word )
+    {
+        for( uint32_t pending = candidates[word] ; pending ; pending &= pending - 1 )
+        {
+            int i = ( word << 5 ) + __builtin_ctz( pending );
+            if( px >= platforms->x[i] + platforms->width[i] || px + pw <= platforms->x[i] ) continue;
+
+            int16_t top = platforms->y[i];
+            if( feet >= top && feet <= top + platforms->height[i] && feet + gravity > top )
+            {
+                // Entre vários apoios, fica com a superfície mais alta
+                if( best == PLATFORM_NONE || top < platforms->y[best] ) best = i;
+            }
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,125 @@
+#include "replay.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define REPLAY_RUN_BUTTONS( run ) ( ( run ) >> 6 )
+#define REPLAY_RUN_LENGTH( run ) ( ( ( run ) & 0x3F ) + 1 )
+
+static void REPLAY_PutWord( uint8_t* data , uint32_t value )
+{
+    for( int i = 0 ; i < 4 ; ++i ) data[i] = ( value >> ( 8 * i ) ) & 0xFF;
+}
+
+static uint32_t REPLAY_GetWord( const uint8_t* data )
+{
+    return (uint32_t)data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+REPLAY_t* REPLAY_Init( size_t capacity )
+{
+    REPLAY_t* replay;
+
+    assert( capacity > REPLAY_HEADER_SIZE );
+
+    replay = (REPLAY_t*)malloc( sizeof ( REPLAY_t ) );
+    assert( replay != NULL );
+
+    replay->data = (uint8_t*)malloc( capacity );
+    assert( replay->data != NULL );
+
+    replay->capacity = capacity;
+    REPLAY_Start( replay , 0 );
+
+    return replay;
+}
+
+// Descarta o conteúdo e começa uma gravação nova para a semente dada
+void REPLAY_Start( REPLAY_t* replay , uint32_t seed )
+{
+    replay->data[0] = REPLAY_MAGIC_0;
+    replay->data[1] = REPLAY_MAGIC_1;
+    replay->data[2] = REPLAY_VERSION;
+    REPLAY_PutWord( &replay->data[3] , seed );
+    REPLAY_PutWord( &replay->data[7] , 0 );
+
+    replay->size = REPLAY_HEADER_SIZE;
+    replay->seed = seed;
+    REPLAY_Rewind( replay );
+}
+
+// Acrescenta uma amostra; devolve false se o buffer encheu (a amostra é perdida)
+bool REPLAY_Record( REPLAY_t* replay , uint8_t buttons )
+{
+    buttons &= REPLAY_BUTTON_A | REPLAY_BUTTON_B;
+
+    if( replay->size > REPLAY_HEADER_SIZE )
+    {
+        uint8_t* last = &replay->data[replay->size - 1];
+        if( REPLAY_RUN_BUTTONS( *last ) == buttons && REPLAY_RUN_LENGTH( *last ) < REPLAY_RUN_MAX )
+        {
+            ( *last )++;
+            return true;
+        }
+    }
+
+    if( replay->size >= replay->capacity ) return false;
+
+    replay->data[replay->size++] = buttons << 6;
+    // Número de corridas no cabeçalho: um fluxo cortado no meio não passa por REPLAY_Load
+    REPLAY_PutWord( &replay->data[7] , replay->size - REPLAY_HEADER_SIZE );
+    return true;
+}
+
+// Copia um fluxo gravado (ex.: lido de arquivo) e o prepara para leitura
+bool REPLAY_Load( REPLAY_t* replay , const uint8_t* data , size_t size )
+{
+    if( size < REPLAY_HEADER_SIZE || size > replay->capacity ) return false;
+    if( data[0] != REPLAY_MAGIC_0 || data[1] != REPLAY_MAGIC_1 || data[2] != REPLAY_VERSION ) return false;
+    if( REPLAY_GetWord( &data[7] ) != size - REPLAY_HEADER_SIZE ) return false;
+
+    memcpy( replay->data , data , size );
+    replay->size = size;
+    replay->seed = REPLAY_GetWord( &data[3] );
+    REPLAY_Rewind( replay );
+
+    return true;
+}
+
+void REPLAY_Rewind( REPLAY_t* replay )
+{
+    replay->cursor = REPLAY_HEADER_SIZE;
+    replay->remaining = 0;
+    replay->buttons = 0;
+}
+
+// Próxima amostra gravada; ao fim do fluxo devolve false com os botões soltos
+bool REPLAY_Next( REPLAY_t* replay , uint8_t* buttons )
+{
+    if( !replay->remaining )
+    {
+        if( replay->cursor >= replay->size )
+        {
+            *buttons = 0;
+            return false;
+        }
+
+        uint8_t run = replay->data[replay->cursor++];
+        replay->buttons = REPLAY_RUN_BUTTONS( run );
+        replay->remaining = REPLAY_RUN_LENGTH( run );
+    }
+
+    replay->remaining--;
+    *buttons = replay->buttons;
+    return true;
+}
+
+// Total de amostras no fluxo (duração = amostras * GAME_INPUT_PERIOD_MS)
+uint32_t REPLAY_GetSamples( const REPLAY_t* replay )
+{
+    uint32_t samples = 0;
+
+    for( size_t i = REPLAY_HEADER_SIZE ; i < replay->size ; ++i ) samples += REPLAY_RUN_LENGTH( replay->data[i] );
+
+    return samples;
+}
@@ -0,0 +1,202 @@
+#include "solver.h"
+#include <string.h>
+#include <assert.h>
+
+#define SOLVER_ROWS ( SOLVER_Y_MAX - SOLVER_Y_MIN )
+#define SOLVER_WORDS ( ( SOLVER_MAX_WIDTH * SOLVER_ROWS + 31 ) / 32 )
+
+#define SOLVER_INPUT_EVERY ( GAME_INPUT_PERIOD_MS / GAME_LOGIC_PERIOD_MS )
+#define SOLVER_FIRST_INPUT_TICK ( ( STATE_TRANSITION_DEBOUNCE_MS + GAME_LOGIC_PERIOD_MS - 1 ) / GAME_LOGIC_PERIOD_MS )
+
+#define SOLVER_MAX_PLATFORMS 32                     // Plataformas de um nível (cabem numa máscara)
+#define SOLVER_TERRAIN SOLVER_MAX_PLATFORMS         // Apoio no terreno, depois das plataformas
+#define SOLVER_AIR ( -1 )
+
+typedef struct
+{
+    int16_t x[SOLVER_MAX_STATES];
+    int16_t y[SOLVER_MAX_STATES];
+    uint16_t rank[SOLVER_MAX_STATES]; // Quanto maior, mais perto da meta; decide quem sai quando o feixe enche
+    int8_t support[SOLVER_MAX_STATES]; // Plataforma, SOLVER_TERRAIN ou SOLVER_AIR
+    uint16_t count;
+}SOLVER_LAYER_t;
+
+// Estático: o solver roda na tarefa que monta os níveis, sem pilha nem heap para isso
+static CHAOS_GAME_TLS PLATFORMS_t solver_platforms;
+static CHAOS_GAME_TLS SOLVER_LAYER_t solver_layers[2];
+static CHAOS_GAME_TLS uint32_t solver_seen[SOLVER_WORDS];
+static CHAOS_GAME_TLS uint32_t solver_cover[SOLVER_MAX_WIDTH]; // Plataformas sob [x, x + PLAYER_WIDTH)
+static CHAOS_GAME_TLS int16_t solver_owner[SOLVER_TERRAIN + 1]; // Estado do próximo tick sobre cada apoio (-1: nenhum)
+
+static inline uint32_t SOLVER_Index( int x , int y )
+{
+    return (uint32_t)( y - SOLVER_Y_MIN ) * SOLVER_MAX_WIDTH + (uint32_t)x;
+}
+
+static inline void SOLVER_Mark( int x , int y , bool seen )
+{
+    uint32_t index = SOLVER_Index( x , y );
+    if( seen ) solver_seen[index >> 5] |= 1u << ( index & 31 );
+    else solver_seen[index >> 5] &= ~( 1u << ( index & 31 ) );
+}
+
+// Apoiados vêm antes dos que estão no ar; entre iguais, o mais à direita
+static inline uint16_t SOLVER_Rank( int x , int support )
+{
+    return (uint16_t)( x + ( support != SOLVER_AIR ? SOLVER_MAX_WIDTH : 0 ) );
+}
+
+// Feixe cheio: o estado novo entra no lugar do pior, se for melhor que ele
+static bool SOLVER_Replace( SOLVER_LAYER_t* layer , uint16_t rank )
+{
+    int worst = 0;
+    for( int s = 1 ; s < layer->count ; ++s )
+    {
+        if( layer->rank[s] < layer->rank[worst] ) worst = s;
+    }
+    if( rank <= layer->rank[worst] ) return false;
+
+    int last = --layer->count;
+    SOLVER_Mark( layer->x[worst] , layer->y[worst] , false );
+    if( layer->support[worst] != SOLVER_AIR && solver_owner[layer->support[worst]] == worst ) solver_owner[layer->support[worst]] = -1;
+    if( layer->support[last] != SOLVER_AIR && solver_owner[layer->support[last]] == last ) solver_owner[layer->support[last]] = worst;
+    layer->x[worst] = layer->x[last];
+    layer->y[worst] = layer->y[last];
+    layer->rank[worst] = layer->rank[last];
+    layer->support[worst] = layer->support[last];
+    return true;
+}
+
+// No modo níveis as plataformas só se movem na vertical: quem cobre cada x é fixo no nível todo
+static void SOLVER_BuildCover( void )
+{
+    memset( solver_cover , 0 , sizeof( solver_cover ) );
+    assert( solver_platforms.count <= SOLVER_MAX_PLATFORMS );
+
+    for( int i = 0 ; i < solver_platforms.count ; ++i )
+    {
+        int first = solver_platforms.x[i] - PLAYER_WIDTH + 1;
+        int last = solver_platforms.x[i] + solver_platforms.width[i] - 1;
+        if( first < 0 ) first = 0;
+        if( last >= SOLVER_MAX_WIDTH ) last = SOLVER_MAX_WIDTH - 1;
+        for( int x = first ; x <= last ; ++x ) solver_cover[x] |= 1u << i;
+    }
+}
+
+// Mesmo resultado de PLATFORMS_FindSupport, com os candidatos já filtrados por x
+static inline int SOLVER_FindSupport( int x , int y )
+{
+    int16_t feet = y + PLAYER_HEIGHT;
+    int best = PLATFORM_NONE;
+
+    for( uint32_t pending = solver_cover[x] ; pending ; pending &= pending - 1 )
+    {
+        int i = __builtin_ctz( pending );
+        int16_t top = solver_platforms.y[i];
+        if( feet >= top && feet <= top + solver_platforms.height[i] && feet + PLAYER_GRAVITY > top )
+        {
+            if( best == PLATFORM_NONE || top < solver_platforms.y[best] ) best = i;
+        }
+    }
+
+    return best;
+}
+
+// Resolve o nível a partir do seu tick inicial. Cada tick repete a ordem do jogo: entrada
+// (a cada GAME_INPUT_PERIOD_MS, depois do debounce de início), movimento das plataformas e física do personagem.
+SOLVER_RESULT_t SOLVER_Run( const GAME_LEVEL_t* level , int speed , uint32_t max_ticks , uint32_t max_expanded , uint16_t max_states )
+{
+    SOLVER_RESULT_t result = { 0 };
+    SOLVER_LAYER_t* current = &solver_layers[0];
+    SOLVER_LAYER_t* next = &solver_layers[1];
+
+    assert( level->world_width <= SOLVER_MAX_WIDTH );
+    assert( max_states > 0 && max_states <= SOLVER_MAX_STATES );
+
+    memcpy( &solver_platforms , &level->platforms , sizeof( solver_platforms ) );
+    memset( solver_seen , 0 , sizeof( solver_seen ) );
+    SOLVER_BuildCover();
+    current->x[0] = level->player_x;
+    current->y[0] = level->player_y;
+    current->count = 1;
+
+    for( uint32_t tick = 0 ; tick < max_ticks && current->count ; ++tick )
+    {
+        if( result.expanded >= max_expanded )
+        {
+            result.exhausted = true;
+            break;
+        }
+
+        bool input = tick >= SOLVER_FIRST_INPUT_TICK && tick % SOLVER_INPUT_EVERY == 0;
+        int options = input ? 2 : 1; // nada ou B (direita)
+
+        PLATFORMS_Move( &solver_platforms , &gPlatformBounds );
+        next->count = 0;
+        memset( solver_owner , -1 , sizeof( solver_owner ) );
+
+        for( int s = 0 ; s < current->count ; ++s )
+        {
+            for( int option = 0 ; option < options ; ++option )
+            {
+                int x = GAME_LevelInputX( current->x[s] , false , option == 1 , speed , level->world_width );
+                int y = current->y[s];
+
+                if( option && x == current->x[s] ) continue; // Encostado no limite: igual a não apertar
+
+                int platform = SOLVER_FindSupport( x , y );
+                GAME_PLAYER_STEP_t step = GAME_StepPlayer( &solver_platforms , &level->terrain , level->goal_x , platform , &x , &y );
+                result.expanded++;
+
+                if( step == GAME_PLAYER_GOAL )
+                {
+                    result.solvable = true;
+                    result.ticks = tick + 1;
+                    return result;
+                }
+                if( step == GAME_PLAYER_DEAD || y < SOLVER_Y_MIN || y >= SOLVER_Y_MAX || x < 0 || x >= SOLVER_MAX_WIDTH ) continue;
+
+                uint32_t index = SOLVER_Index( x , y );
+                if( solver_seen[index >> 5] & ( 1u << ( index & 31 ) ) ) continue;
+
+                int support = SOLVER_AIR;
+                if( step == GAME_PLAYER_SUPPORTED ) support = ( platform == PLATFORM_NONE ) ? SOLVER_TERRAIN : platform;
+                uint16_t rank = SOLVER_Rank( x , support );
+
+                // Sobre o mesmo apoio, na mesma altura e sob as mesmas plataformas, o mais à direita domina:
+                // basta esperar até a hora em que o outro chegaria andando e seguir igual a ele
+                int owner = ( support != SOLVER_AIR ) ? solver_owner[support] : -1;
+                if( owner >= 0 && next->y[owner] == y && solver_cover[next->x[owner]] == solver_cover[x] )
+                {
+                    if( x < next->x[owner] ) continue;
+                    SOLVER_Mark( next->x[owner] , y , false );
+                    SOLVER_Mark( x , y , true );
+                    next->x[owner] = x;
+                    next->rank[owner] = rank;
+                    continue;
+                }
+
+                if( next->count == max_states )
+                {
+                    result.truncated = true;
+                    if( !SOLVER_Replace( next , rank ) ) continue;
+                }
+                SOLVER_Mark( x , y , true );
+                if( support != SOLVER_AIR && owner < 0 ) solver_owner[support] = next->count;
+                next->x[next->count] = x;
+                next->y[next->count] = y;
+                next->rank[next->count] = rank;
+                next->support[next->count] = support;
+                next->count++;
+            }
+        }
+
+        // Limpa só os bits marcados neste tick, em vez do bitset inteiro
+        for( int s = 0 ; s < next->count ; ++s ) SOLVER_Mark( next->x[s] , next->y[s] , false );
+        if( next->count > result.peak_states ) result.peak_states = next->count;
+
+        SOLVER_LAYER_t* swap = current; current = next; next = swap;
+    }
+
+    return result;
+}
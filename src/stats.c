@@ -0,0 +1,224 @@
+#include <include/stats.h>
+#include <stdio.h>
+#include <assert.h>
+#include "pico/time.h"
+#include "alloc.h"
+
+static TaskStatus_t stats_tasks[STATS_MAX_TASKS];
+static uint32_t stats_last_runtime[STATS_MAX_TASKS]; // Por xTaskNumber, da chamada anterior
+static uint32_t stats_last_total;
+
+static TaskHandle_t stats_watch_handle[STATS_MAX_TASKS];
+static uint32_t stats_watch_depth[STATS_MAX_TASKS];
+static int stats_watch_count;
+
+typedef struct
+{
+    TaskHandle_t task; // NULL: antes do escalonador
+    const char* name;
+    uint32_t bytes;
+    uint32_t count;
+}STATS_HEAP_OWNER_t;
+
+static STATS_HEAP_OWNER_t stats_heap_owners[STATS_MAX_TASKS];
+static int stats_heap_owner_count;
+static size_t stats_failed_malloc;
+
+// Escritos pelas tarefas de entrada e do display (núcleos diferentes com SMP); palavras de 32 bits
+static volatile uint32_t stats_input_edge_us; // 0: nenhuma mudança esperando um quadro
+static volatile uint32_t stats_frames;
+static volatile uint32_t stats_latency_sum_us;
+static volatile uint32_t stats_latency_max_us;
+static volatile uint32_t stats_latency_count;
+static volatile uint32_t stats_switches; // Incrementado só pelo kernel, na troca de contexto
+
+// 32 bits baixos do timer: dá a volta a cada ~71 min, mas as diferenças entre chamadas continuam certas
+uint32_t STATS_RunTimeCounter( void )
+{
+    return (uint32_t)time_us_64();
+}
+
+void STATS_Watch( TaskHandle_t task , uint32_t depth )
+{
+    assert( stats_watch_count < STATS_MAX_TASKS );
+
+    stats_watch_handle[stats_watch_count] = task;
+    stats_watch_depth[stats_watch_count] = depth;
+    stats_watch_count++;
+}
+
+static uint32_t STATS_WatchedDepth( TaskHandle_t task )
+{
+    for( int i = 0 ; i < stats_watch_count ; ++i )
+    {
+        if( stats_watch_handle[i] == task ) return stats_watch_depth[i];
+    }
+
+    return 0;
+}
+
+// Máximo já usado + 25%, arredondado para cima, nunca abaixo de configMINIMAL_STACK_SIZE
+static uint32_t STATS_RecommendedDepth( uint32_t used )
+{
+    uint32_t depth = used + used / 4;
+
+    depth = ( depth + STATS_STACK_ROUND - 1 ) / STATS_STACK_ROUND * STATS_STACK_ROUND;
+    return depth < configMINIMAL_STACK_SIZE ? configMINIMAL_STACK_SIZE : depth;
+}
+
+void STATS_InputEdge( uint32_t now_us )
+{
+    if( stats_input_edge_us == 0 ) stats_input_edge_us = now_us ? now_us : 1;
+}
+
+void STATS_FrameSent( uint32_t start_us , uint32_t end_us )
+{
+    uint32_t edge = stats_input_edge_us;
+
+    stats_frames++;
+    if( edge != 0 && (int32_t)( start_us - edge ) >= 0 )
+    {
+        uint32_t latency = end_us - edge;
+        stats_latency_sum_us += latency;
+        if( latency > stats_latency_max_us ) stats_latency_max_us = latency;
+        stats_latency_count++;
+        stats_input_edge_us = 0;
+    }
+}
+
+void STATS_TaskSwitchedIn( void )
+{
+    stats_switches++;
+}
+
+static char STATS_StateLetter( eTaskState state )
+{
+    switch( state )
+    {
+        case eRunning: return 'X';
+        case eReady: return 'R';
+        case eBlocked: return 'B';
+        case eSuspended: return 'S';
+        case eDeleted: return 'D';
+        default: return '?';
+    }
+}
+
+void STATS_Print( void )
+{
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t count = uxTaskGetSystemState( stats_tasks , STATS_MAX_TASKS , &total );
+    uint32_t elapsed = (uint32_t)total - stats_last_total;
+
+    stats_last_total = (uint32_t)total;
+    if( elapsed == 0 ) elapsed = 1;
+
+    printf( "\n%-16s %8s %6s %6s %5s %6s %6s %8s\n" ,
+            "tarefa" , "us" , "cpu %" , "estado" , "prio" , "pilha" , "livre" , "sugerida" );
+
+    for( UBaseType_t i = 0 ; i < count ; ++i )
+    {
+        const TaskStatus_t* task = &stats_tasks[i];
+        UBaseType_t slot = task->xTaskNumber % STATS_MAX_TASKS;
+        uint32_t runtime = (uint32_t)task->ulRunTimeCounter - stats_last_runtime[slot];
+        uint32_t permille = (uint32_t)( (uint64_t)runtime * 1000 / elapsed );
+        uint32_t depth = STATS_WatchedDepth( task->xHandle );
+        uint32_t free_words = task->usStackHighWaterMark; // Mínimo livre desde a criação, em palavras
+
+        stats_last_runtime[slot] = (uint32_t)task->ulRunTimeCounter;
+
+        printf( "%-16s %8lu %4lu.%lu %6c %5lu " ,
+                task->pcTaskName , (unsigned long)runtime ,
+                (unsigned long)( permille / 10 ) , (unsigned long)( permille % 10 ) ,
+                STATS_StateLetter( task->eCurrentState ) , (unsigned long)task->uxCurrentPriority );
+
+        if( depth ) printf( "%6lu %6lu %8lu\n" , (unsigned long)depth , (unsigned long)free_words ,
+                            (unsigned long)STATS_RecommendedDepth( depth - free_words ) );
+        else printf( "%6s %6lu %8s\n" , "-" , (unsigned long)free_words , "-" );
+    }
+
+    if( count == 0 ) printf( "mais de %d tarefas: aumente STATS_MAX_TASKS\n" , STATS_MAX_TASKS );
+
+    // Quadros por segundo no período e latência botão → tela
+    uint32_t frames = stats_frames , samples = stats_latency_count;
+    uint32_t fps_x10 = (uint32_t)( (uint64_t)frames * 10000000 / elapsed );
+    printf( "display: %lu.%lu quadros/s, latencia botao->tela media %lu us, max %lu us (%lu amostras)\n" ,
+            (unsigned long)( fps_x10 / 10 ) , (unsigned long)( fps_x10 % 10 ) ,
+            (unsigned long)( samples ? stats_latency_sum_us / samples : 0 ) ,
+            (unsigned long)stats_latency_max_us , (unsigned long)samples );
+    stats_frames = 0; stats_latency_sum_us = 0; stats_latency_max_us = 0; stats_latency_count = 0;
+
+    // Cada troca acorda a CPU: com a tela dormindo devem sobrar quase só as desta tarefa
+    uint32_t switches = stats_switches;
+    uint32_t switches_x10 = (uint32_t)( (uint64_t)switches * 10000000 / elapsed );
+    printf( "cpu: %lu.%lu trocas de contexto/s\n" ,
+            (unsigned long)( switches_x10 / 10 ) , (unsigned long)( switches_x10 % 10 ) );
+    stats_switches -= switches;
+}
+
+// Roda dentro de pvPortMalloc, com o escalonador suspenso: a tabela não precisa de trava
+void STATS_TraceMalloc( void* address , size_t size )
+{
+    TaskHandle_t task = NULL;
+    int i;
+
+    if( address == NULL )
+    {
+        stats_failed_malloc = size;
+        return;
+    }
+
+    if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) task = xTaskGetCurrentTaskHandle();
+
+    for( i = 0 ; i < stats_heap_owner_count && stats_heap_owners[i].task != task ; ++i );
+
+    if( i == stats_heap_owner_count )
+    {
+        if( i == STATS_MAX_TASKS ) return;
+        stats_heap_owners[i].task = task;
+        stats_heap_owners[i].name = task ? pcTaskGetName( task ) : "boot";
+        stats_heap_owner_count++;
+    }
+
+    stats_heap_owners[i].bytes += size;
+    stats_heap_owners[i].count++;
+}
+
+size_t STATS_GetFailedMalloc( void )
+{
+    return stats_failed_malloc;
+}
+
+void STATS_PrintHeap( void )
+{
+    HeapStats_t heap;
+
+    vPortGetHeapStats( &heap );
+
+    size_t used = configTOTAL_HEAP_SIZE - heap.xAvailableHeapSpaceInBytes;
+    size_t peak = configTOTAL_HEAP_SIZE - heap.xMinimumEverFreeBytesRemaining;
+    // Fragmentação: quanto do espaço livre não cabe no maior bloco
+    size_t fragmented = heap.xAvailableHeapSpaceInBytes ?
+        100 - heap.xSizeOfLargestFreeBlockInBytes * 100 / heap.xAvailableHeapSpaceInBytes : 0;
+
+    printf( "\nheap: %lu/%lu bytes em uso, pico %lu, maior bloco livre %lu, %lu blocos livres (fragmentacao %lu%%), %lu alocacoes, %lu liberacoes\n" ,
+            (unsigned long)used , (unsigned long)configTOTAL_HEAP_SIZE , (unsigned long)peak ,
+            (unsigned long)heap.xSizeOfLargestFreeBlockInBytes , (unsigned long)heap.xNumberOfFreeBlocks ,
+            (unsigned long)fragmented , (unsigned long)heap.xNumberOfSuccessfulAllocations ,
+            (unsigned long)heap.xNumberOfSuccessfulFrees );
+
+    for( int i = 0 ; i < stats_heap_owner_count ; ++i )
+    {
+        printf( "  %-16s %8lu bytes %5lu alocacoes\n" , stats_heap_owners[i].name ,
+                (unsigned long)stats_heap_owners[i].bytes , (unsigned long)stats_heap_owners[i].count );
+    }
+
+    // Os drivers usam o malloc da libc, fora do heap do FreeRTOS
+    printf( "malloc dos drivers:\n" );
+    for( HAL_ALLOC_TAG_t tag = 0 ; tag < HAL_ALLOC_TAGS ; ++tag )
+    {
+        const HAL_ALLOC_STATS_t* alloc = HAL_GetAllocStats( tag );
+        if( alloc->count ) printf( "  %-16s %8lu bytes %5lu alocacoes\n" , HAL_GetAllocName( tag ) ,
+                                   (unsigned long)alloc->bytes , (unsigned long)alloc->count );
+    }
+}
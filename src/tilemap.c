@@ -0,0 +1,103 @@
+#include "tilemap.h"
+#include <string.h>
+
+extern const uint8_t tile_atlas_8x8[];
+extern const uint8_t tile_solid_from[];
+
+static inline int TILEMAP_Wrap( int column )
+{
+    return column & ( TILEMAP_COLUMNS - 1 );
+}
+
+void TILEMAP_Clear( TILEMAP_t* map )
+{
+    memset( map , 0 , sizeof( TILEMAP_t ) );
+}
+
+void TILEMAP_ClearColumns( TILEMAP_t* map , int x , int width )
+{
+    int first = x >> 3;
+    int last = ( x + width - 1 ) >> 3;
+
+    for( int c = first ; c <= last && c - first < TILEMAP_COLUMNS ; ++c )
+    {
+        int column = TILEMAP_Wrap( c );
+        memset( map->tiles[column] , TILE_EMPTY , TILEMAP_ROWS );
+        map->solid[column] = 0;
+        map->occupied[column] = 0;
+    }
+}
+
+void TILEMAP_SetTile( TILEMAP_t* map , int column , int row , uint8_t tile )
+{
+    if( row < 0 || row >= TILEMAP_ROWS || tile >= TILE_COUNT ) return;
+
+    column = TILEMAP_Wrap( column );
+    uint8_t mask = 1u << row;
+
+    map->tiles[column][row] = tile;
+    if( tile_solid_from[tile] < TILE_SIZE ) { map->solid[column] |= mask; } else { map->solid[column] &= ~mask; }
+    if( tile != TILE_EMPTY ) { map->occupied[column] |= mask; } else { map->occupied[column] &= ~mask; }
+}
+
+// Terreno com topo na linha y (px), de x até x + width; x e width devem ser múltiplos de TILE_SIZE
+void TILEMAP_FillGround( TILEMAP_t* map , int x , int y , int width )
+{
+    int top_row = y >> 3;
+    int offset = y & 7;
+    int parity = y & 1;
+
+    for( int c = x >> 3 ; c < ( x + width ) >> 3 ; ++c )
+    {
+        TILEMAP_SetTile( map , c , top_row , TILE_GROUND_TOP + offset );
+        for( int row = top_row + 1 ; row < TILEMAP_ROWS ; ++row )
+        {
+            if( row == top_row + 1 && offset + TILE_GROUND_BAND > TILE_SIZE )
+            {
+                TILEMAP_SetTile( map , c , row , TILE_GROUND_SPILL + offset - ( TILE_SIZE - TILE_GROUND_BAND + 1 ) );
+            }else
+            {
+                TILEMAP_SetTile( map , c , row , TILE_GROUND_FILL + parity );
+            }
+        }
+    }
+}
+
+bool TILEMAP_IsSolid( const TILEMAP_t* map , int x , int y )
+{
+    if( y < 0 || y >= TILEMAP_ROWS * TILE_SIZE ) return false;
+
+    int column = TILEMAP_Wrap( x >> 3 );
+    int row = y >> 3;
+
+    // Rejeição pelo mapa de bits; só então consulta a primeira linha sólida do tile
+    if( !( ( map->solid[column] >> row ) & 1 ) ) return false;
+
+    return ( y & 7 ) >= tile_solid_from[map->tiles[column][row]];
+}
+
+void TILEMAP_Render( const TILEMAP_t* map , D1306_t* D1306 , int camera_x )
+{
+    int first = camera_x >> 3;
+    int last = ( camera_x + D1306->width - 1 ) >> 3;
+
+    for( int c = first ; c <= last ; ++c )
+    {
+        int column = TILEMAP_Wrap( c );
+        uint8_t rows = map->occupied[column];
+        if( !rows ) continue;
+
+        // Recorte horizontal: a coluna de tiles pode estar parcialmente visível
+        int screen_x = ( c << 3 ) - camera_x;
+        int skip = screen_x < 0 ? -screen_x : 0;
+        int count = TILE_SIZE - skip;
+        if( screen_x + TILE_SIZE > D1306->width ) count = D1306->width - screen_x;
+
+        for( int row = 0 ; rows && row < D1306->pages ; ++row , rows >>= 1 )
+        {
+            if( !( rows & 1 ) ) continue;
+            const uint8_t* tile = &tile_atlas_8x8[map->tiles[column][row] * TILE_SIZE];
+            D1306_BlitPage( D1306 , screen_x + skip , row , tile + skip , count );
+        }
+    }
+}
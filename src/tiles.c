@@ -0,0 +1,31 @@
+#include <stdint.h>
+
+// Tiles 8x8 no formato de página do SSD1306: 8 bytes por tile, um por coluna, bit 0 no topo.
+// Terreno: faixa sólida de 4 linhas no topo (TOP + deslocamento dentro da página),
+// continuação da faixa na página seguinte (SPILL) e pontilhado por paridade de linha (FILL).
+const uint8_t tile_atlas_8x8[] =
+{
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x5F, 0x0F, 0x5F, 0x0F, 0x5F, 0x0F, 0x5F, 0x0F,
+			0xBE, 0x1E, 0xBE, 0x1E, 0xBE, 0x1E, 0xBE, 0x1E,
+			0x7C, 0x3C, 0x7C, 0x3C, 0x7C, 0x3C, 0x7C, 0x3C,
+			0xF8, 0x78, 0xF8, 0x78, 0xF8, 0x78, 0xF8, 0x78,
+			0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+			0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+			0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+			0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+			0xAB, 0x01, 0xAB, 0x01, 0xAB, 0x01, 0xAB, 0x01,
+			0x57, 0x03, 0x57, 0x03, 0x57, 0x03, 0x57, 0x03,
+			0xAF, 0x07, 0xAF, 0x07, 0xAF, 0x07, 0xAF, 0x07,
+			0x55, 0x00, 0x55, 0x00, 0x55, 0x00, 0x55, 0x00,
+			0xAA, 0x00, 0xAA, 0x00, 0xAA, 0x00, 0xAA, 0x00,
+};
+
+// Primeira linha sólida de cada tile (8 = tile sem colisão)
+const uint8_t tile_solid_from[] =
+{
+			8,
+			0, 1, 2, 3, 4, 5, 6, 7,
+			0, 0, 0,
+			0, 0,
+};
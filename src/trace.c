@@ -0,0 +1,85 @@
+#include "trace.h"
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#define TRACE_MAX_TASKS 16
+
+static TRACE_EVENT_t trace_ring[TRACE_CAPACITY];
+static uint32_t trace_head;         // Total de eventos gravados desde o último dump
+static bool trace_paused;           // Lido e escrito só com a trava
+static spin_lock_t* trace_lock;     // Trava de hardware: protege o anel dos dois núcleos e das interrupções
+static TaskStatus_t trace_tasks[TRACE_MAX_TASKS];
+static UBaseType_t trace_next_number; // Número dado à próxima tarefa; 0 fica para as ainda sem número
+
+void TRACE_Init( void )
+{
+    trace_lock = spin_lock_init( spin_lock_claim_unused( true ) );
+}
+
+void TRACE_Record( TRACE_TYPE_t type , uint16_t arg )
+{
+    if( trace_lock == NULL ) return;
+
+    uint32_t saved = spin_lock_blocking( trace_lock );
+    if( !trace_paused )
+    {
+        TRACE_EVENT_t* event = &trace_ring[trace_head++ & ( TRACE_CAPACITY - 1 )];
+        event->time_us = (uint32_t)time_us_64();
+        event->type = type;
+        event->core = get_core_num();
+        event->arg = arg;
+    }
+    spin_unlock( trace_lock , saved );
+}
+
+void TRACE_NumberTask( void* task )
+{
+    vTaskSetTaskNumber( (TaskHandle_t)task , ++trace_next_number );
+}
+
+void TRACE_NumberTasks( void )
+{
+    UBaseType_t tasks = uxTaskGetSystemState( trace_tasks , TRACE_MAX_TASKS , NULL );
+    for( UBaseType_t i = 0 ; i < tasks ; ++i )
+    {
+        if( uxTaskGetTaskNumber( trace_tasks[i].xHandle ) == 0 ) TRACE_NumberTask( trace_tasks[i].xHandle );
+    }
+}
+
+// Chamada pelo kernel dentro da troca de contexto: só lê o número guardado no TCB
+void TRACE_TaskSwitchedIn( void* tcb )
+{
+    TRACE_Record( TRACE_TASK_IN , (uint16_t)uxTaskGetTaskNumber( (TaskHandle_t)tcb ) );
+}
+
+void TRACE_Dump( void )
+{
+    uint32_t saved = spin_lock_blocking( trace_lock );
+    trace_paused = true;
+    spin_unlock( trace_lock , saved );
+
+    uint32_t total = trace_head;
+    uint32_t count = total < TRACE_CAPACITY ? total : TRACE_CAPACITY;
+    UBaseType_t tasks = uxTaskGetSystemState( trace_tasks , TRACE_MAX_TASKS , NULL );
+
+    printf( "TRACE BEGIN %lu %lu\n" , (unsigned long)count , (unsigned long)( total - count ) );
+    for( UBaseType_t i = 0 ; i < tasks ; ++i )
+    {
+        // O mesmo número dos eventos TRACE_TASK_IN (não o xTaskNumber do kernel)
+        printf( "T %lu %s\n" , (unsigned long)uxTaskGetTaskNumber( trace_tasks[i].xHandle ) , trace_tasks[i].pcTaskName );
+    }
+    for( uint32_t i = total - count ; i != total ; ++i )
+    {
+        const TRACE_EVENT_t* event = &trace_ring[i & ( TRACE_CAPACITY - 1 )];
+        printf( "E %lu %u %u %u\n" , (unsigned long)event->time_us , event->core , event->type , event->arg );
+    }
+    printf( "TRACE END\n" );
+
+    saved = spin_lock_blocking( trace_lock );
+    trace_head = 0;
+    trace_paused = false;
+    spin_unlock( trace_lock , saved );
+}